@@ -129,6 +129,7 @@
 // Files in the directory returned by GetUserPath(D_MEMORYWATCHER_IDX)
 #define MEMORYWATCHER_LOCATIONS "Locations.txt"
 #define MEMORYWATCHER_SOCKET "MemoryWatcher"
+#define MEMORYWATCHER_CONTROL_SOCKET "Control"
 
 // Sys files
 #define TOTALDB "totaldb.dsy"
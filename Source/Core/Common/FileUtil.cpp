@@ -891,6 +891,8 @@ static void RebuildUserDirectories(unsigned int dir_index)
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_LOCATIONS;
     s_user_paths[F_MEMORYWATCHERSOCKET_IDX] =
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SOCKET;
+    s_user_paths[F_MEMORYWATCHERCONTROLSOCKET_IDX] =
+        s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_CONTROL_SOCKET;
 
     s_user_paths[D_GBAUSER_IDX] = s_user_paths[D_USER_IDX] + GBA_USER_DIR DIR_SEP;
     s_user_paths[D_GBASAVES_IDX] = s_user_paths[D_GBAUSER_IDX] + GBASAVES_DIR DIR_SEP;
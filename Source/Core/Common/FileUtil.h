@@ -87,6 +87,7 @@ enum
   F_GCSRAM_IDX,
   F_MEMORYWATCHERLOCATIONS_IDX,
   F_MEMORYWATCHERSOCKET_IDX,
+  F_MEMORYWATCHERCONTROLSOCKET_IDX,
   F_WIISDCARDIMAGE_IDX,
   F_DUALSHOCKUDPCLIENTCONFIG_IDX,
   F_FREELOOKCONFIG_IDX,
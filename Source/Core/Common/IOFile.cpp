@@ -3,12 +3,16 @@
 
 #include "Common/IOFile.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <cstddef>
 #include <cstdio>
 #include <string>
 
 #ifdef _WIN32
 #include <io.h>
+#include <windows.h>
 
 #include "Common/CommonFuncs.h"
 #include "Common/StringUtil.h"
@@ -22,6 +26,7 @@
 #include "jni/AndroidCommon/AndroidCommon.h"
 #endif
 
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 
@@ -61,6 +66,7 @@ void IOFile::Swap(IOFile& other) noexcept
 {
   std::swap(m_file, other.m_file);
   std::swap(m_good, other.m_good);
+  std::swap(m_position_unknown, other.m_position_unknown);
 }
 
 bool IOFile::Open(const std::string& filename, const char openmode[],
@@ -98,6 +104,7 @@ bool IOFile::Close()
     m_good = false;
 
   m_file = nullptr;
+  m_position_unknown = false;
   return m_good;
 }
 
@@ -110,6 +117,54 @@ IOFile IOFile::Duplicate(const char openmode[]) const
 #endif  // _WIN32
 }
 
+bool IOFile::ReadAt(void* data, size_t length, u64 offset) const
+{
+  if (!IsOpen())
+    return false;
+
+  // Only Windows actually moves the file position, but mixing the calls is caught everywhere
+  std::atomic_ref(m_position_unknown).store(true, std::memory_order_relaxed);
+
+  u8* out = static_cast<u8*>(data);
+
+#ifdef _WIN32
+  const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file)));
+  while (length > 0)
+  {
+    // The file wasn't opened with FILE_FLAG_OVERLAPPED, so this is a synchronous read from the
+    // offset in the OVERLAPPED structure
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    const DWORD bytes_to_read = static_cast<DWORD>(std::min<size_t>(length, 0x80000000));
+    DWORD bytes_read = 0;
+    if (!ReadFile(handle, out, bytes_to_read, &bytes_read, &overlapped) || bytes_read == 0)
+      return false;
+
+    offset += bytes_read;
+    length -= bytes_read;
+    out += bytes_read;
+  }
+#else
+  const int fd = fileno(m_file);
+  while (length > 0)
+  {
+    const ssize_t bytes_read = pread(fd, out, length, static_cast<off_t>(offset));
+    if (bytes_read < 0 && errno == EINTR)
+      continue;
+    if (bytes_read <= 0)
+      return false;
+
+    offset += bytes_read;
+    length -= bytes_read;
+    out += bytes_read;
+  }
+#endif
+
+  return true;
+}
+
 void IOFile::SetHandle(std::FILE* file)
 {
   Close();
@@ -143,6 +198,11 @@ bool IOFile::Seek(s64 offset, SeekOrigin origin)
     return false;
   }
 
+  if (origin == SeekOrigin::Current)
+    AssertPositionKnown();
+  else
+    m_position_unknown = false;
+
   if (!IsOpen() || 0 != fseeko(m_file, offset, fseek_origin))
     m_good = false;
 
@@ -151,12 +211,20 @@ bool IOFile::Seek(s64 offset, SeekOrigin origin)
 
 u64 IOFile::Tell() const
 {
+  AssertPositionKnown();
+
   if (IsOpen())
     return ftello(m_file);
   else
     return UINT64_MAX;
 }
 
+void IOFile::AssertPositionKnown() const
+{
+  DEBUG_ASSERT_MSG(COMMON, !std::atomic_ref(m_position_unknown).load(std::memory_order_relaxed),
+                   "The file position was moved by ReadAt and has to be set with Seek first");
+}
+
 bool IOFile::Flush()
 {
   if (!IsOpen() || 0 != std::fflush(m_file))
@@ -51,11 +51,15 @@ public:
             SharedAccess sh = SharedAccess::Default);
   bool Close();
 
+  // The duplicate shares the file position with this file, so the two can only be used from
+  // different threads at once if all reads go through ReadAt.
   IOFile Duplicate(const char openmode[]) const;
 
   template <typename T>
   bool ReadArray(T* elements, size_t count, size_t* num_read = nullptr)
   {
+    AssertPositionKnown();
+
     size_t read_count = 0;
     if (!IsOpen() || count != (read_count = std::fread(elements, sizeof(T), count, m_file)))
       m_good = false;
@@ -69,6 +73,8 @@ public:
   template <typename T>
   bool WriteArray(const T* elements, size_t count)
   {
+    AssertPositionKnown();
+
     if (!IsOpen() || count != std::fwrite(elements, sizeof(T), count, m_file))
       m_good = false;
 
@@ -99,6 +105,12 @@ public:
 
   bool WriteString(std::string_view str) { return WriteBytes(str.data(), str.size()); }
 
+  // Reads length bytes starting at offset without using the file position. Unlike the other
+  // functions, this doesn't update the error state, so it can be called from several threads at
+  // once. On Windows this does move the file position, without the buffering of the other
+  // functions noticing, so the file has to be seeked to an absolute position before they're used.
+  bool ReadAt(void* data, size_t length, u64 offset) const;
+
   bool IsOpen() const { return nullptr != m_file; }
   // m_good is set to false when a read, write or other function fails
   bool IsGood() const { return m_good; }
@@ -121,8 +133,12 @@ public:
   }
 
 private:
+  void AssertPositionKnown() const;
+
   std::FILE* m_file;
   bool m_good;
+  // Set by ReadAt and cleared by seeking to an absolute position
+  mutable bool m_position_unknown = false;
 };
 
 }  // namespace File
@@ -3,11 +3,18 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -15,7 +22,9 @@
 #include "Common/Assert.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
+#include "Core/CheatSearchInternal.h"
 #include "Core/Config/AchievementSettings.h"
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -198,20 +207,137 @@ TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
 {
   return PowerPC::MMU::HostTryReadF64(guard, addr, space);
 }
-}  // namespace
+
+// Returns whether values read from the given address space are translated
+bool IsTranslated(const Core::CPUThreadGuard& guard, PowerPC::RequestedAddressSpace space)
+{
+  return space == PowerPC::RequestedAddressSpace::Virtual ||
+         (space == PowerPC::RequestedAddressSpace::Effective &&
+          guard.GetSystem().GetPPCState().msr.DR);
+}
+
+// Returns the host memory backing the given page of emulated memory, or nullptr if its values have
+// to be read through the MMU. Looking it up needs the MMU, so it has to happen while holding the
+// CPUThreadGuard on the calling thread, but values can then be read from it on any thread.
+const u8* GetHostPage(const Core::CPUThreadGuard& guard, u32 page_address,
+                      PowerPC::RequestedAddressSpace space)
+{
+  auto& system = guard.GetSystem();
+  const auto& ppc_state = system.GetPPCState();
+
+  // Values are read from the emulated data cache rather than from memory when it's enabled
+  if (ppc_state.m_enable_dcache)
+    return nullptr;
+
+  u32 physical_address = page_address;
+  if (IsTranslated(guard, space))
+  {
+    if (!ppc_state.msr.DR)
+      return nullptr;
+
+    const std::optional<u32> translated_address =
+        system.GetMMU().GetTranslatedAddress(page_address);
+    if (!translated_address)
+      return nullptr;
+    physical_address = *translated_address;
+  }
+
+  // The same regions PowerPC::MMU::HostIsRAMAddress accepts
+  auto& memory = system.GetMemory();
+  const u32 segment = physical_address >> 28;
+  const u32 offset = physical_address & 0x0FFFFFFF;
+  if (memory.GetRAM() && segment == 0x0 && offset < memory.GetRamSizeReal())
+    return memory.GetRAM() + offset;
+  if (memory.GetEXRAM() && segment == 0x1 && offset < memory.GetExRamSizeReal())
+    return memory.GetEXRAM() + offset;
+  if (memory.GetFakeVMEM() && (physical_address & 0xFE000000) == 0x7E000000)
+    return memory.GetFakeVMEM() + (physical_address & memory.GetFakeVMemMask());
+  if (memory.GetL1Cache() && segment == 0xE && offset < memory.GetL1CacheSize())
+    return memory.GetL1Cache() + offset;
+  return nullptr;
+}
 
 template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const Core::CPUThreadGuard& guard,
-                  const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+bool CrossesPage(u32 addr)
+{
+  return (addr & PowerPC::HW_PAGE_MASK) + sizeof(T) > PowerPC::HW_PAGE_SIZE;
+}
+
+template <typename T>
+T ReadValueFromHostPage(const u8* page, u32 addr)
+{
+  T value;
+  std::memcpy(&value, page + (addr & PowerPC::HW_PAGE_MASK), sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+// Calls func with every index in [0, count) using all available cores
+template <typename Func>
+void ParallelFor(size_t count, const Func& func)
+{
+  const size_t thread_count =
+      std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+
+  std::atomic<size_t> next_index = 0;
+  const auto run = [&] {
+    for (size_t i = next_index++; i < count; i = next_index++)
+      func(i);
+  };
+
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < thread_count; ++i)
+    futures.push_back(std::async(std::launch::async, run));
+
+  run();
+
+  for (std::future<void>& future : futures)
+    future.wait();
+}
+
+// Calls func with every index in [0, count). The indices for which on_calling_thread returns true
+// are handled first, in order, on the calling thread, since their values have to be read through
+// the MMU. All other indices are handled on all cores.
+template <typename SerialFunc, typename Func>
+void ForEachChunk(size_t count, const SerialFunc& on_calling_thread, const Func& func)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (on_calling_thread(i))
+      func(i);
+  }
+  ParallelFor(count, [&](size_t i) {
+    if (!on_calling_thread(i))
+      func(i);
+  });
+}
+
+// Returns one bit per candidate in [0, count), set if is_match returns true for it. The bits are
+// built a whole word at a time without branches, so that the compiler can inline and vectorize the
+// comparisons.
+template <typename Func>
+std::vector<u64> FindMatches(u32 count, const Func& is_match)
+{
+  std::vector<u64> bits((count + 63) / 64);
+  for (size_t word = 0; word < bits.size(); ++word)
+  {
+    const u32 begin = static_cast<u32>(word * 64);
+    const u32 end = std::min<u32>(count, begin + 64);
+    u64 matches = 0;
+    for (u32 i = begin; i < end; ++i)
+      matches |= u64{is_match(i)} << (i - begin);
+    bits[word] = matches;
+  }
+  return bits;
+}
+
+// Returns why a search can't run right now, or SearchErrorCode::Success if it can.
+Cheats::SearchErrorCode CheckSearchPossible(const Core::CPUThreadGuard& guard,
+                                            PowerPC::RequestedAddressSpace address_space)
 {
 #ifdef USE_RETRO_ACHIEVEMENTS
   if (Config::Get(Config::RA_HARDCORE_ENABLED))
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
 #endif  // USE_RETRO_ACHIEVEMENTS
-  std::vector<Cheats::SearchResult<T>> results;
   const Core::State core_state = Core::GetState();
   if (core_state != Core::State::Running && core_state != Core::State::Paused)
     return Cheats::SearchErrorCode::NoEmulationActive;
@@ -220,6 +346,29 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
+  return Cheats::SearchErrorCode::Success;
+}
+
+// The searches take the validator as a template parameter, so that CheatSearchSession can pass
+// its comparisons without going through a std::function for every value.
+template <typename T, typename Validator>
+Cheats::SearchResults<T> SearchMemoryImpl(const Core::CPUThreadGuard& guard,
+                                          const std::vector<Cheats::MemoryRange>& memory_ranges,
+                                          PowerPC::RequestedAddressSpace address_space,
+                                          bool aligned, const Validator& validator)
+{
+  // Translating addresses needs the MMU, but the translation is the same for a whole page. So the
+  // host memory backing each page is looked up here, and the values in the pages are then read and
+  // checked on all cores. Values that cross into the next page or aren't backed by host memory are
+  // read through the MMU on this thread.
+  struct Chunk
+  {
+    u32 first_address;
+    u32 count;
+    const u8* page;
+  };
+  std::vector<Chunk> chunks;
+
   for (const Cheats::MemoryRange& range : memory_ranges)
   {
     if (range.m_length < sizeof(T))
@@ -233,72 +382,346 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
       continue;
 
     const u64 length = aligned_length - (sizeof(T) - 1);
-    for (u64 i = 0; i < length; i += increment_per_loop)
+    const u64 end_address = start_address + length;
+    u64 addr = start_address;
+    while (addr < end_address)
+    {
+      const u64 page_address = addr & ~u64{PowerPC::HW_PAGE_MASK};
+      const u64 page_end = page_address + PowerPC::HW_PAGE_SIZE;
+      const auto add_chunk = [&](u64 end, const u8* page) {
+        if (addr >= end)
+          return;
+        const u64 count = (end - addr + increment_per_loop - 1) / increment_per_loop;
+        chunks.push_back({static_cast<u32>(addr), static_cast<u32>(count), page});
+        addr += count * increment_per_loop;
+      };
+
+      const u64 fitting_end = std::min(end_address, page_end - (sizeof(T) - 1));
+      if (addr < fitting_end)
+        add_chunk(fitting_end, GetHostPage(guard, static_cast<u32>(page_address), address_space));
+      add_chunk(std::min(end_address, page_end), nullptr);
+    }
+  }
+
+  const u32 increment = aligned ? sizeof(T) : 1;
+  const auto on_calling_thread = [&](size_t i) { return chunks[i].page == nullptr; };
+
+  std::vector<std::vector<u64>> matches(chunks.size());
+  ForEachChunk(chunks.size(), on_calling_thread, [&](size_t i) {
+    const Chunk& chunk = chunks[i];
+    if (chunk.page)
+    {
+      matches[i] = FindMatches(chunk.count, [&](u32 j) {
+        return validator(ReadValueFromHostPage<T>(chunk.page, chunk.first_address + j * increment));
+      });
+    }
+    else
     {
-      const u32 addr = start_address + i;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-      if (!current_value)
-        continue;
+      matches[i] = FindMatches(chunk.count, [&](u32 j) {
+        const auto value = TryReadValueFromEmulatedMemory<T>(
+            guard, chunk.first_address + j * increment, address_space);
+        return value && validator(value->value);
+      });
+    }
+  });
 
-      if (validator(current_value->value))
+  Cheats::SearchResults<T> results;
+  results.m_translated = IsTranslated(guard, address_space);
+  std::vector<const u8*> block_pages;
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    const Chunk& chunk = chunks[i];
+    if (results.m_addresses.AddBlock(chunk.first_address, increment, chunk.count,
+                                     std::move(matches[i])))
+    {
+      block_pages.push_back(chunk.page);
+    }
+  }
+  matches.clear();
+
+  // Only values that could be read are results, so reading a value again always succeeds
+  const auto& blocks = results.m_addresses.GetBlocks();
+  results.m_values.resize(results.m_addresses.Size());
+  ForEachChunk(
+      blocks.size(), [&](size_t i) { return block_pages[i] == nullptr; },
+      [&](size_t i) {
+        const auto& block = blocks[i];
+        const u8* page = block_pages[i];
+        T* out = results.m_values.data() + block.first_index;
+        block.ForEachResult([&](u32 position) {
+          const u32 addr = block.GetAddress(position);
+          *out++ = page ? ReadValueFromHostPage<T>(page, addr) :
+                          TryReadValueFromEmulatedMemory<T>(guard, addr, address_space)->value;
+        });
+      });
+
+  return results;
+}
+
+template <typename T, typename Validator>
+Cheats::SearchResults<T> SearchPreviousResultsImpl(const Core::CPUThreadGuard& guard,
+                                                   const Cheats::SearchResults<T>& previous_results,
+                                                   PowerPC::RequestedAddressSpace address_space,
+                                                   const Validator& validator)
+{
+  // Like in NewSearch, the host memory backing each block of results is looked up on this thread
+  // and the values are read and checked on all cores. A block never spans more than one page, but
+  // the values at its end may cross into the next one.
+  const auto& previous_blocks = previous_results.m_addresses.GetBlocks();
+  std::vector<const u8*> pages(previous_blocks.size());
+  for (size_t i = 0; i < previous_blocks.size(); ++i)
+  {
+    const auto& block = previous_blocks[i];
+    const u32 last_address = block.GetAddress(block.candidate_count - 1);
+    const u32 page_address = block.first_address & ~PowerPC::HW_PAGE_MASK;
+    if ((last_address & ~PowerPC::HW_PAGE_MASK) == page_address && !CrossesPage<T>(last_address))
+      pages[i] = GetHostPage(guard, page_address, address_space);
+  }
+  const auto on_calling_thread = [&](size_t i) { return pages[i] == nullptr; };
+
+  std::vector<std::vector<u64>> matches(previous_blocks.size());
+  ForEachChunk(previous_blocks.size(), on_calling_thread, [&](size_t i) {
+    const auto& block = previous_blocks[i];
+    const u8* page = pages[i];
+    std::vector<u64>& bits = matches[i];
+    bits.resize((block.candidate_count + 63) / 64);
+
+    const std::vector<size_t>& inaccessible = previous_results.m_inaccessible;
+    auto next_inaccessible =
+        std::lower_bound(inaccessible.begin(), inaccessible.end(), block.first_index);
+    size_t index = block.first_index;
+    block.ForEachResult([&](u32 position) {
+      const u32 addr = block.GetAddress(position);
+      std::optional<T> current_value;
+      if (page)
+        current_value = ReadValueFromHostPage<T>(page, addr);
+      else if (const auto value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space))
+        current_value = value->value;
+
+      const bool was_valid = next_inaccessible == inaccessible.end() || *next_inaccessible != index;
+      if (!was_valid)
+        ++next_inaccessible;
+
+      // Results that can't be read anymore are kept to show that. If the previous state was
+      // invalid, we always update the value to avoid getting stuck in an invalid state.
+      if (!current_value || !was_valid ||
+          validator(*current_value, previous_results.m_values[index]))
       {
-        auto& r = results.emplace_back();
-        r.m_value = current_value->value;
-        r.m_value_state = current_value->translated ?
-                              Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                              Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-        r.m_address = addr;
+        bits[position / 64] |= u64{1} << (position % 64);
       }
+      ++index;
+    });
+  });
+
+  Cheats::SearchResults<T> results;
+  results.m_translated = IsTranslated(guard, address_space);
+  std::vector<const u8*> block_pages;
+  for (size_t i = 0; i < previous_blocks.size(); ++i)
+  {
+    const auto& block = previous_blocks[i];
+    if (results.m_addresses.AddBlock(block.first_address, block.stride, block.candidate_count,
+                                     std::move(matches[i])))
+    {
+      block_pages.push_back(pages[i]);
     }
   }
+  matches.clear();
+
+  // The blocks that are read through the MMU are handled in order on this thread, which keeps the
+  // indices of the inaccessible results sorted
+  const auto& blocks = results.m_addresses.GetBlocks();
+  results.m_values.resize(results.m_addresses.Size());
+  ForEachChunk(
+      blocks.size(), [&](size_t i) { return block_pages[i] == nullptr; },
+      [&](size_t i) {
+        const auto& block = blocks[i];
+        const u8* page = block_pages[i];
+        size_t index = block.first_index;
+        block.ForEachResult([&](u32 position) {
+          const u32 addr = block.GetAddress(position);
+          if (page)
+          {
+            results.m_values[index] = ReadValueFromHostPage<T>(page, addr);
+          }
+          else if (const auto value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space))
+          {
+            results.m_values[index] = value->value;
+          }
+          else
+          {
+            results.m_values[index] = T{};
+            results.m_inaccessible.push_back(index);
+          }
+          ++index;
+        });
+      });
+
   return results;
 }
+}  // namespace
 
-template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NextSearch(const Core::CPUThreadGuard& guard,
-                   const std::vector<Cheats::SearchResult<T>>& previous_results,
-                   PowerPC::RequestedAddressSpace address_space,
-                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
+bool Cheats::SearchResultAddresses::AddBlock(u32 first_address, u32 stride, u32 candidate_count,
+                                             std::vector<u64> bits)
 {
-#ifdef USE_RETRO_ACHIEVEMENTS
-  if (Config::Get(Config::RA_HARDCORE_ENABLED))
-    return Cheats::SearchErrorCode::DisabledInHardcoreMode;
-#endif  // USE_RETRO_ACHIEVEMENTS
-  std::vector<Cheats::SearchResult<T>> results;
-  const Core::State core_state = Core::GetState();
-  if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    return Cheats::SearchErrorCode::NoEmulationActive;
+  // Positions are stored as u16
+  DEBUG_ASSERT(candidate_count <= 0x10000);
 
-  const auto& ppc_state = guard.GetSystem().GetPPCState();
-  if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
-    return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
+  size_t result_count = 0;
+  for (const u64 word : bits)
+    result_count += std::popcount(word);
+  if (result_count == 0)
+    return false;
+
+  Block block{first_address, stride, candidate_count, m_size, result_count, std::move(bits), {}};
+
+  // A list of positions takes less memory than the bits if only a few of the candidates are results
+  if (result_count * sizeof(u16) < block.bits.size() * sizeof(u64))
+  {
+    std::vector<u16> positions;
+    positions.reserve(result_count);
+    block.ForEachResult([&](u32 position) { positions.push_back(static_cast<u16>(position)); });
+    block.bits = {};
+    block.positions = std::move(positions);
+  }
 
-  for (const auto& previous_result : previous_results)
+  m_size += result_count;
+  m_blocks.push_back(std::move(block));
+  return true;
+}
+
+u32 Cheats::SearchResultAddresses::Get(size_t index) const
+{
+  const auto block =
+      std::prev(std::upper_bound(m_blocks.begin(), m_blocks.end(), index,
+                                 [](size_t i, const Block& b) { return i < b.first_index; }));
+  size_t remaining = index - block->first_index;
+  if (!block->positions.empty())
+    return block->GetAddress(block->positions[remaining]);
+
+  for (size_t word = 0;; ++word)
   {
-    const u32 addr = previous_result.m_address;
-    const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-    if (!current_value)
+    u64 bits = block->bits[word];
+    const size_t count = std::popcount(bits);
+    if (remaining < count)
     {
-      auto& r = results.emplace_back();
-      r.m_address = addr;
-      r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
-      continue;
+      for (; remaining != 0; --remaining)
+        bits &= bits - 1;
+      return block->GetAddress(static_cast<u32>(word * 64 + std::countr_zero(bits)));
     }
+    remaining -= count;
+  }
+}
 
-    // if the previous state was invalid we always update the value to avoid getting stuck in an
-    // invalid state
-    if (!previous_result.IsValueValid() || validator(current_value->value, previous_result.m_value))
+Cheats::SearchResultAddresses Cheats::SearchResultAddresses::Slice(size_t begin, size_t end) const
+{
+  SearchResultAddresses slice;
+  for (const Block& block : m_blocks)
+  {
+    const size_t block_end = block.first_index + block.result_count;
+    if (block_end <= begin || block.first_index >= end)
+      continue;
+
+    if (block.first_index >= begin && block_end <= end)
     {
-      auto& r = results.emplace_back();
-      r.m_value = current_value->value;
-      r.m_value_state = current_value->translated ?
-                            Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                            Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-      r.m_address = addr;
+      Block& copy = slice.m_blocks.emplace_back(block);
+      copy.first_index = slice.m_size;
+      slice.m_size += block.result_count;
+      continue;
     }
+
+    std::vector<u64> bits((block.candidate_count + 63) / 64);
+    size_t index = block.first_index;
+    block.ForEachResult([&](u32 position) {
+      if (index >= begin && index < end)
+        bits[position / 64] |= u64{1} << (position % 64);
+      ++index;
+    });
+    slice.AddBlock(block.first_address, block.stride, block.candidate_count, std::move(bits));
   }
-  return results;
+  return slice;
+}
+
+template <typename T>
+Cheats::SearchResultValueState Cheats::SearchResults<T>::GetValueState(size_t index) const
+{
+  if (!IsValueValid(index))
+    return SearchResultValueState::AddressNotAccessible;
+  return m_translated ? SearchResultValueState::ValueFromVirtualMemory :
+                        SearchResultValueState::ValueFromPhysicalMemory;
+}
+
+template <typename T>
+bool Cheats::SearchResults<T>::IsValueValid(size_t index) const
+{
+  return m_inaccessible.empty() ||
+         !std::binary_search(m_inaccessible.begin(), m_inaccessible.end(), index);
+}
+
+template <typename T>
+Cheats::SearchResult<T> Cheats::SearchResults<T>::Get(size_t index) const
+{
+  return {m_values[index], GetValueState(index), m_addresses.Get(index)};
+}
+
+template <typename T>
+Cheats::SearchResults<T> Cheats::SearchResults<T>::Slice(size_t begin, size_t end) const
+{
+  SearchResults slice;
+  slice.m_addresses = m_addresses.Slice(begin, end);
+  slice.m_values.assign(m_values.begin() + begin, m_values.begin() + end);
+  slice.m_translated = m_translated;
+  const auto first = std::lower_bound(m_inaccessible.begin(), m_inaccessible.end(), begin);
+  const auto last = std::lower_bound(first, m_inaccessible.end(), end);
+  for (auto it = first; it != last; ++it)
+    slice.m_inaccessible.push_back(*it - begin);
+  return slice;
+}
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const T& value)>& validator)
+{
+  const Cheats::SearchErrorCode error = CheckSearchPossible(guard, address_space);
+  if (error != Cheats::SearchErrorCode::Success)
+    return error;
+
+  return SearchMemory(guard, memory_ranges, address_space, aligned, validator);
+}
+
+template <typename T>
+Cheats::SearchResults<T>
+Cheats::SearchMemory(const Core::CPUThreadGuard& guard,
+                     const std::vector<Cheats::MemoryRange>& memory_ranges,
+                     PowerPC::RequestedAddressSpace address_space, bool aligned,
+                     const std::function<bool(const T& value)>& validator)
+{
+  return SearchMemoryImpl<T>(guard, memory_ranges, address_space, aligned, validator);
+}
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<T>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
+{
+  const Cheats::SearchErrorCode error = CheckSearchPossible(guard, address_space);
+  if (error != Cheats::SearchErrorCode::Success)
+    return error;
+
+  return SearchPreviousResults(guard, previous_results, address_space, validator);
+}
+
+template <typename T>
+Cheats::SearchResults<T> Cheats::SearchPreviousResults(
+    const Core::CPUThreadGuard& guard, const Cheats::SearchResults<T>& previous_results,
+    PowerPC::RequestedAddressSpace address_space,
+    const std::function<bool(const T& new_value, const T& old_value)>& validator)
+{
+  return SearchPreviousResultsImpl<T>(guard, previous_results, address_space, validator);
 }
 
 Cheats::CheatSearchSessionBase::~CheatSearchSessionBase() = default;
@@ -373,113 +796,81 @@ template <typename T>
 void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
-  m_search_results.clear();
-}
-
-template <typename T>
-static std::function<bool(const T& new_value)>
-MakeCompareFunctionForSpecificValue(Cheats::CompareType op, const T& old_value)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return [&](const T& new_value) { return new_value == old_value; };
-  case Cheats::CompareType::NotEqual:
-    return [&](const T& new_value) { return new_value != old_value; };
-  case Cheats::CompareType::Less:
-    return [&](const T& new_value) { return new_value < old_value; };
-  case Cheats::CompareType::LessOrEqual:
-    return [&](const T& new_value) { return new_value <= old_value; };
-  case Cheats::CompareType::Greater:
-    return [&](const T& new_value) { return new_value > old_value; };
-  case Cheats::CompareType::GreaterOrEqual:
-    return [&](const T& new_value) { return new_value >= old_value; };
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
-  }
+  m_search_results = {};
 }
 
-template <typename T>
-static std::function<bool(const T& old_value, const T& new_value)>
-MakeCompareFunctionForLastValue(Cheats::CompareType op)
+// Calls func with the function object for the given comparison, so that the comparison can be
+// inlined into the search
+template <typename T, typename Func>
+static auto WithComparison(Cheats::CompareType op, const Func& func)
 {
   switch (op)
   {
   case Cheats::CompareType::Equal:
-    return std::equal_to<T>();
+    return func(std::equal_to<T>());
   case Cheats::CompareType::NotEqual:
-    return std::not_equal_to<T>();
+    return func(std::not_equal_to<T>());
   case Cheats::CompareType::Less:
-    return std::less<T>();
+    return func(std::less<T>());
   case Cheats::CompareType::LessOrEqual:
-    return std::less_equal<T>();
+    return func(std::less_equal<T>());
   case Cheats::CompareType::Greater:
-    return std::greater<T>();
+    return func(std::greater<T>());
   case Cheats::CompareType::GreaterOrEqual:
-    return std::greater_equal<T>();
+    return func(std::greater_equal<T>());
   default:
     DEBUG_ASSERT(false);
-    return nullptr;
+    return func(std::equal_to<T>());
   }
 }
 
 template <typename T>
 Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPUThreadGuard& guard)
 {
-#ifdef USE_RETRO_ACHIEVEMENTS
-  if (Config::Get(Config::RA_HARDCORE_ENABLED))
-    return Cheats::SearchErrorCode::DisabledInHardcoreMode;
-#endif  // USE_RETRO_ACHIEVEMENTS
-  Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
-      Cheats::SearchErrorCode::InvalidParameters;
+  if (m_filter_type == FilterType::CompareAgainstSpecificValue && !m_value)
+    return Cheats::SearchErrorCode::InvalidParameters;
+  if (m_filter_type == FilterType::CompareAgainstLastValue && !m_first_search_done)
+    return Cheats::SearchErrorCode::InvalidParameters;
+
+  const Cheats::SearchErrorCode error = CheckSearchPossible(guard, m_address_space);
+  if (error != Cheats::SearchErrorCode::Success)
+    return error;
+
+  const auto new_search = [&](const auto& validator) {
+    return SearchMemoryImpl<T>(guard, m_memory_ranges, m_address_space, m_aligned, validator);
+  };
+  const auto next_search = [&](const auto& validator) {
+    return SearchPreviousResultsImpl<T>(guard, m_search_results, m_address_space, validator);
+  };
+
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
   {
-    if (!m_value)
-      return Cheats::SearchErrorCode::InvalidParameters;
-
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(
-          guard, m_search_results, m_address_space,
-          [&func](const T& new_value, const T& old_value) { return func(new_value); });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, func);
-    }
+    const T value = *m_value;
+    m_search_results = WithComparison<T>(m_compare_type, [&](const auto& compare) {
+      if (m_first_search_done)
+        return next_search([&](const T& new_value, const T&) { return compare(new_value, value); });
+      return new_search([&](const T& new_value) { return compare(new_value, value); });
+    });
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
   {
-    if (!m_first_search_done)
-      return Cheats::SearchErrorCode::InvalidParameters;
-
-    result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
+    m_search_results = WithComparison<T>(
+        m_compare_type, [&](const auto& compare) { return next_search(compare); });
   }
   else if (m_filter_type == FilterType::DoNotFilter)
   {
     if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
-    }
+      m_search_results = next_search([](const T&, const T&) { return true; });
     else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
-    }
+      m_search_results = new_search([](const T&) { return true; });
   }
-
-  if (result.Succeeded())
+  else
   {
-    m_search_results = std::move(*result);
-    m_first_search_done = true;
-    return Cheats::SearchErrorCode::Success;
+    return Cheats::SearchErrorCode::InvalidParameters;
   }
 
-  return result.Error();
+  m_first_search_done = true;
+  return Cheats::SearchErrorCode::Success;
 }
 
 template <typename T>
@@ -527,38 +918,31 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
-  return m_search_results.size();
+  return m_search_results.Size();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
-  const auto& results = m_search_results;
-  size_t count = 0;
-  for (const auto& r : results)
-  {
-    if (r.IsValueValid())
-      ++count;
-  }
-  return count;
+  return m_search_results.GetValidValueCount();
 }
 
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
-  return m_search_results[index].m_address;
+  return m_search_results.m_addresses.Get(index);
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
-  return m_search_results[index].m_value;
+  return m_search_results.m_values[index];
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{m_search_results.m_values[index]};
 }
 
 template <typename T>
@@ -570,21 +954,21 @@ std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index,
   if (hex)
   {
     if constexpr (std::is_same_v<T, float>)
-      return fmt::format("0x{0:08x}", Common::BitCast<u32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", Common::BitCast<u32>(m_search_results.m_values[index]));
     else if constexpr (std::is_same_v<T, double>)
-      return fmt::format("0x{0:016x}", Common::BitCast<u64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", Common::BitCast<u64>(m_search_results.m_values[index]));
     else
-      return fmt::format("0x{0:0{1}x}", m_search_results[index].m_value, sizeof(T) * 2);
+      return fmt::format("0x{0:0{1}x}", m_search_results.m_values[index], sizeof(T) * 2);
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", m_search_results.m_values[index]);
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
-  return m_search_results[index].m_value_state;
+  return m_search_results.GetValueState(index);
 }
 
 template <typename T>
@@ -603,13 +987,12 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size_t end_index) const
 {
-  if (begin_index == 0 && end_index >= m_search_results.size())
+  if (begin_index == 0 && end_index >= m_search_results.Size())
     return Clone();
 
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results.assign(m_search_results.begin() + begin_index,
-                             m_search_results.begin() + end_index);
+  c->m_search_results = m_search_results.Slice(begin_index, end_index);
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
@@ -617,6 +1000,17 @@ Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size
   return c;
 }
 
+template struct Cheats::SearchResults<u8>;
+template struct Cheats::SearchResults<u16>;
+template struct Cheats::SearchResults<u32>;
+template struct Cheats::SearchResults<u64>;
+template struct Cheats::SearchResults<s8>;
+template struct Cheats::SearchResults<s16>;
+template struct Cheats::SearchResults<s32>;
+template struct Cheats::SearchResults<s64>;
+template struct Cheats::SearchResults<float>;
+template struct Cheats::SearchResults<double>;
+
 template class Cheats::CheatSearchSession<u8>;
 template class Cheats::CheatSearchSession<u16>;
 template class Cheats::CheatSearchSession<u32>;
@@ -669,3 +1063,119 @@ Cheats::MakeSession(std::vector<MemoryRange> memory_ranges,
     return nullptr;
   }
 }
+
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<u8>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const u8& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<u8>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<u8>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const u8&, const u8&)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<u16>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const u16& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<u16>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<u16>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const u16&, const u16&)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<u32>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const u32& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<u32>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<u32>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const u32&, const u32&)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<u64>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const u64& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<u64>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<u64>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const u64&, const u64&)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<s8>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const s8& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<s8>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<s8>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const s8&, const s8&)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<s16>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const s16& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<s16>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<s16>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const s16&, const s16&)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<s32>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const s32& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<s32>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<s32>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const s32&, const s32&)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<s64>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const s64& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<s64>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<s64>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const s64&, const s64&)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<float>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const float& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<float>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<float>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const float&, const float&)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<double>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const double& value)>& validator);
+template Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<double>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<double>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const double&, const double&)>& validator);
+
+template Cheats::SearchResults<u8>
+Cheats::SearchMemory(const Core::CPUThreadGuard& guard,
+                     const std::vector<Cheats::MemoryRange>& memory_ranges,
+                     PowerPC::RequestedAddressSpace address_space, bool aligned,
+                     const std::function<bool(const u8& value)>& validator);
+template Cheats::SearchResults<u32>
+Cheats::SearchMemory(const Core::CPUThreadGuard& guard,
+                     const std::vector<Cheats::MemoryRange>& memory_ranges,
+                     PowerPC::RequestedAddressSpace address_space, bool aligned,
+                     const std::function<bool(const u32& value)>& validator);
+template Cheats::SearchResults<u32> Cheats::SearchPreviousResults(
+    const Core::CPUThreadGuard& guard, const Cheats::SearchResults<u32>& previous_results,
+    PowerPC::RequestedAddressSpace address_space,
+    const std::function<bool(const u32& new_value, const u32& old_value)>& validator);
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <bit>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -78,6 +80,79 @@ struct SearchResult
   }
 };
 
+// The addresses of a set of search results. Searches go over memory one page at a time, so the
+// addresses are stored in blocks of evenly spaced candidate addresses within a page, either as one
+// bit per candidate or, if only a few of the candidates are results, as a list of their positions.
+class SearchResultAddresses
+{
+public:
+  struct Block
+  {
+    u32 first_address;
+    u32 stride;
+    u32 candidate_count;
+
+    // Index of the first result of this block in the whole set
+    size_t first_index;
+    size_t result_count;
+
+    // Only one of these is used
+    std::vector<u64> bits;
+    std::vector<u16> positions;
+
+    u32 GetAddress(u32 position) const { return first_address + position * stride; }
+
+    // Calls func with the position of each result of this block, in order.
+    template <typename Func>
+    void ForEachResult(const Func& func) const
+    {
+      for (const u16 position : positions)
+        func(u32{position});
+      for (size_t word = 0; word < bits.size(); ++word)
+      {
+        for (u64 remaining = bits[word]; remaining != 0; remaining &= remaining - 1)
+          func(static_cast<u32>(word * 64 + std::countr_zero(remaining)));
+      }
+    }
+  };
+
+  // Adds a block whose results are the candidates with a set bit. Returns false without adding
+  // anything if there are none.
+  bool AddBlock(u32 first_address, u32 stride, u32 candidate_count, std::vector<u64> bits);
+
+  size_t Size() const { return m_size; }
+  u32 Get(size_t index) const;
+  const std::vector<Block>& GetBlocks() const { return m_blocks; }
+
+  // Returns the addresses with indices in [begin, end).
+  SearchResultAddresses Slice(size_t begin, size_t end) const;
+
+private:
+  std::vector<Block> m_blocks;
+  size_t m_size = 0;
+};
+
+// The results of a search. All values of a search are read from the same address space, so only
+// the address and the value are stored per result, along with the sorted indices of the results
+// whose address couldn't be accessed.
+template <typename T>
+struct SearchResults
+{
+  SearchResultAddresses m_addresses;
+  std::vector<T> m_values;
+  bool m_translated = false;
+  std::vector<size_t> m_inaccessible;
+
+  size_t Size() const { return m_values.size(); }
+  size_t GetValidValueCount() const { return Size() - m_inaccessible.size(); }
+  SearchResultValueState GetValueState(size_t index) const;
+  bool IsValueValid(size_t index) const;
+  SearchResult<T> Get(size_t index) const;
+
+  // Returns the results with indices in [begin, end).
+  SearchResults Slice(size_t begin, size_t end) const;
+};
+
 struct MemoryRange
 {
   u32 m_start;
@@ -117,7 +192,7 @@ std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 // Do a new search across the given memory region in the given address space, only keeping values
 // for which the given validator returns true.
 template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
+Common::Result<SearchErrorCode, SearchResults<T>>
 NewSearch(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& memory_ranges,
           PowerPC::RequestedAddressSpace address_space, bool aligned,
           const std::function<bool(const T& value)>& validator);
@@ -125,8 +200,8 @@ NewSearch(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& mem
 // Refresh the values for the given results in the given address space, only keeping values for
 // which the given validator returns true.
 template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
-NextSearch(const Core::CPUThreadGuard& guard, const std::vector<SearchResult<T>>& previous_results,
+Common::Result<SearchErrorCode, SearchResults<T>>
+NextSearch(const Core::CPUThreadGuard& guard, const SearchResults<T>& previous_results,
            PowerPC::RequestedAddressSpace address_space,
            const std::function<bool(const T& new_value, const T& old_value)>& validator);
 
@@ -219,7 +294,7 @@ public:
                                                        size_t end_index) const override;
 
 private:
-  std::vector<SearchResult<T>> m_search_results;
+  SearchResults<T> m_search_results;
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
@@ -0,0 +1,32 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "Core/CheatSearch.h"
+#include "Core/PowerPC/MMU.h"
+
+namespace Core
+{
+class CPUThreadGuard;
+};
+
+namespace Cheats
+{
+// NewSearch and NextSearch without the checks for whether a search can currently run, so that the
+// unit tests can search memory without running a game.
+template <typename T>
+SearchResults<T> SearchMemory(const Core::CPUThreadGuard& guard,
+                              const std::vector<MemoryRange>& memory_ranges,
+                              PowerPC::RequestedAddressSpace address_space, bool aligned,
+                              const std::function<bool(const T& value)>& validator);
+
+template <typename T>
+SearchResults<T>
+SearchPreviousResults(const Core::CPUThreadGuard& guard, const SearchResults<T>& previous_results,
+                      PowerPC::RequestedAddressSpace address_space,
+                      const std::function<bool(const T& new_value, const T& old_value)>& validator);
+}  // namespace Cheats
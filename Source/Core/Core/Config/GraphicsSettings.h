@@ -65,6 +65,7 @@ extern const Info<std::string> GFX_DUMP_FORMAT;
 extern const Info<std::string> GFX_DUMP_CODEC;
 extern const Info<std::string> GFX_DUMP_PIXEL_FORMAT;
 extern const Info<std::string> GFX_DUMP_ENCODER;
+extern const Info<bool> GFX_DUMP_HARDWARE_ENCODER;
 extern const Info<std::string> GFX_DUMP_PATH;
 extern const Info<int> GFX_BITRATE_KBPS;
 extern const Info<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS;
@@ -84,9 +85,12 @@ extern const Info<bool> GFX_BORDERLESS_FULLSCREEN;
 extern const Info<bool> GFX_ENABLE_VALIDATION_LAYER;
 extern const Info<bool> GFX_BACKEND_MULTITHREADING;
 extern const Info<int> GFX_COMMAND_BUFFER_EXECUTE_INTERVAL;
+extern const Info<int> GFX_PRESENT_QUEUE_DEPTH;
+extern const Info<bool> GFX_PREFER_MAILBOX_PRESENT;
 extern const Info<bool> GFX_SHADER_CACHE;
 extern const Info<bool> GFX_WAIT_FOR_SHADERS_BEFORE_STARTING;
 extern const Info<ShaderCompilationMode> GFX_SHADER_COMPILATION_MODE;
+extern const Info<bool> GFX_PARTIALLY_SPECIALIZED_UBERSHADERS;
 extern const Info<int> GFX_SHADER_COMPILER_THREADS;
 extern const Info<int> GFX_SHADER_PRECOMPILER_THREADS;
 extern const Info<bool> GFX_SAVE_TEXTURE_CACHE_TO_STATE;
@@ -153,6 +157,7 @@ static constexpr int GFX_STEREO_CONVERGENCE_MAXIMUM = 200;
 
 extern const Info<bool> GFX_HACK_EFB_ACCESS_ENABLE;
 extern const Info<bool> GFX_HACK_EFB_DEFER_INVALIDATION;
+extern const Info<bool> GFX_HACK_EFB_ASYNC_PEEKS;
 extern const Info<int> GFX_HACK_EFB_ACCESS_TILE_SIZE;
 extern const Info<bool> GFX_HACK_BBOX_ENABLE;
 extern const Info<bool> GFX_HACK_FORCE_PROGRESSIVE;
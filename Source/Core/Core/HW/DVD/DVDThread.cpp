@@ -3,6 +3,9 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -11,6 +14,9 @@
 #include <utility>
 #include <vector>
 
+#include <fmt/format.h>
+
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
@@ -33,9 +39,24 @@
 
 #include "DiscIO/Enums.h"
 #include "DiscIO/Volume.h"
+#include "DiscIO/VolumeWii.h"
 
 namespace DVD
 {
+// The size of the blocks that DVDInterface splits reads into (except on Wii discs with hashes,
+// where the blocks contain VolumeWii::BLOCK_DATA_SIZE bytes of partition data)
+constexpr u64 DVD_ECC_BLOCK_SIZE = 0x8000;
+
+// How many reads in a row need to continue where the previous read ended before we start reading
+// ahead. Reads of more than one block get split into several requests, so this is reached early on
+// in any large read.
+constexpr u32 MIN_SEQUENTIAL_READS = 2;
+
+// How many blocks to keep reading ahead of the emulated software. They are read on the prefetch
+// threads, so that slow host I/O (compressed images, network drives) overlaps with the reads that
+// the DVD thread is doing and with each other.
+constexpr size_t PREFETCH_BLOCK_COUNT = 8;
+
 DVDThread::DVDThread(Core::System& system) : m_system(system)
 {
 }
@@ -55,6 +76,12 @@ void DVDThread::Start()
   // much, because this will never get exposed to the emulated game.
   m_next_id = 0;
 
+  m_stall_count = 0;
+  m_stall_time_us = 0;
+  m_prefetch_hits = 0;
+  m_prefetch_late_hits = 0;
+  m_prefetch_misses = 0;
+
   StartDVDThread();
 }
 
@@ -63,11 +90,24 @@ void DVDThread::StartDVDThread()
   ASSERT(!m_dvd_thread.joinable());
   m_dvd_thread_exiting.Clear();
   m_dvd_thread = std::thread(&DVDThread::DVDThreadMain, this);
+  for (size_t i = 0; i < m_prefetch_threads.size(); ++i)
+  {
+    m_prefetch_threads[i].Reset(fmt::format("DVD prefetch {}", i),
+                                [this](PrefetchRequest request) { PrefetchBlock(request); });
+  }
 }
 
 void DVDThread::Stop()
 {
   StopDVDThread();
+
+  INFO_LOG_FMT(DVDINTERFACE,
+               "Disc reads: {} prefetch hits, {} late prefetch hits, {} misses. "
+               "Emulation waited for the disc {} times ({} ms in total).",
+               m_prefetch_hits, m_prefetch_late_hits, m_prefetch_misses, GetStallCount(),
+               GetStallTimeUs() / 1000);
+
+  DiscardPrefetches();
   m_disc.reset();
 }
 
@@ -82,6 +122,8 @@ void DVDThread::StopDVDThread()
   m_request_queue_expanded.Set();
 
   m_dvd_thread.join();
+  for (auto& thread : m_prefetch_threads)
+    thread.Shutdown(true);
 }
 
 void DVDThread::DoState(PointerWrap& p)
@@ -112,9 +154,14 @@ void DVDThread::DoState(PointerWrap& p)
   if (had_disc != HasDisc())
   {
     if (had_disc)
+    {
       PanicAlertFmtT("An inserted disc was expected but not found.");
+    }
     else
+    {
+      DiscardPrefetches();
       m_disc.reset();
+    }
   }
 
   // TODO: Savestates can be smaller if the buffers of results aren't saved,
@@ -131,6 +178,9 @@ void DVDThread::DoState(PointerWrap& p)
 void DVDThread::SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+
+  // The DVD thread is idle now, so it won't touch the prefetched blocks while they're discarded
+  DiscardPrefetches();
   m_disc = std::move(disc);
 }
 
@@ -278,16 +328,31 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
   }
   else
   {
+    std::optional<u64> stall_started_us;
     while (true)
     {
       while (!m_result_queue.Pop(result))
+      {
+        // The emulated drive is done with the read, but the host isn't
+        if (!stall_started_us)
+          stall_started_us = Common::Timer::NowUs();
         m_result_queue_expanded.Wait();
+      }
 
       if (result.first.id == id)
         break;
       else
         m_result_map.emplace(result.first.id, std::move(result));
     }
+
+    if (stall_started_us)
+    {
+      const u64 stall_time_us = Common::Timer::NowUs() - *stall_started_us;
+      m_stall_count.fetch_add(1, std::memory_order_relaxed);
+      m_stall_time_us.fetch_add(stall_time_us, std::memory_order_relaxed);
+      DEBUG_LOG_FMT(DVDINTERFACE, "Emulation waited {} us for the disc to be read at {:#x}",
+                    stall_time_us, result.first.dvd_offset);
+    }
   }
   // We have now obtained the right ReadResult.
 
@@ -344,9 +409,7 @@ void DVDThread::DVDThreadMain()
     {
       m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
 
-      std::vector<u8> buffer(request.length);
-      if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+      std::vector<u8> buffer = ReadDisc(request);
 
       request.realtime_done_us = Common::Timer::NowUs();
 
@@ -358,4 +421,160 @@ void DVDThread::DVDThreadMain()
     }
   }
 }
+
+std::vector<u8> DVDThread::ReadDisc(const ReadRequest& request)
+{
+  std::vector<u8> buffer(request.length);
+  if (!ReadPrefetchedBlock(request, buffer.data()) &&
+      !m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+  {
+    buffer.resize(0);
+  }
+
+  UpdatePrefetches(request);
+
+  return buffer;
+}
+
+static u64 GetBlockSize(const DiscIO::Volume& disc, const DiscIO::Partition& partition)
+{
+  return partition != DiscIO::PARTITION_NONE && disc.HasWiiHashes() ?
+             DiscIO::VolumeWii::BLOCK_DATA_SIZE :
+             DVD_ECC_BLOCK_SIZE;
+}
+
+bool DVDThread::ReadPrefetchedBlock(const ReadRequest& request, u8* buffer)
+{
+  std::unique_lock lk(m_prefetch_mutex);
+  if (m_prefetched_blocks.empty())
+    return false;
+
+  const u64 block_size = GetBlockSize(*m_disc, request.partition);
+  const u64 block_offset = Common::AlignDown(request.dvd_offset, block_size);
+  if (request.dvd_offset + request.length > block_offset + block_size)
+  {
+    ++m_prefetch_misses;
+    return false;
+  }
+
+  const auto it =
+      std::find_if(m_prefetched_blocks.begin(), m_prefetched_blocks.end(), [&](const auto& block) {
+        return block.partition == request.partition && block.offset == block_offset;
+      });
+  if (it == m_prefetched_blocks.end())
+  {
+    ++m_prefetch_misses;
+    return false;
+  }
+
+  if (!it->used)
+  {
+    ++(it->ready ? m_prefetch_hits : m_prefetch_late_hits);
+    it->used = true;
+  }
+
+  // Only the DVD thread removes blocks, so the iterator stays valid while waiting
+  m_prefetch_cond.wait(lk, [&] { return it->ready; });
+
+  if (it->data.size() != block_size)
+    return false;
+
+  std::memcpy(buffer, it->data.data() + (request.dvd_offset - block_offset), request.length);
+  return true;
+}
+
+void DVDThread::UpdatePrefetches(const ReadRequest& request)
+{
+  const u64 read_end = request.dvd_offset + request.length;
+  const bool sequential =
+      request.partition == m_last_read_partition && request.dvd_offset == m_last_read_end;
+  m_sequential_reads = sequential ? m_sequential_reads + 1 : 0;
+  m_last_read_partition = request.partition;
+  m_last_read_end = read_end;
+
+  // Just like the emulated drive keeps reading past the end of a read into its buffer, we keep
+  // reading the blocks after the last read. Random accesses leave the blocks alone, since they
+  // may be interleaved with a sequential stream (e.g. streamed audio during a level load).
+  if (m_sequential_reads < MIN_SEQUENTIAL_READS)
+    return;
+
+  const u64 block_size = GetBlockSize(*m_disc, request.partition);
+  const u64 window_start = Common::AlignDown(read_end, block_size);
+  const u64 window_end = window_start + PREFETCH_BLOCK_COUNT * block_size;
+
+  std::lock_guard lk(m_prefetch_mutex);
+
+  // Blocks that the stream has moved past are no longer needed. If one of them is still queued, its
+  // prefetch thread skips it, and if it's being read, the prefetch thread drops the result.
+  std::erase_if(m_prefetched_blocks, [&](const PrefetchedBlock& block) {
+    return block.partition != request.partition || block.offset < window_start ||
+           block.offset >= window_end;
+  });
+
+  for (u64 offset = window_start; offset < window_end; offset += block_size)
+  {
+    const bool already_prefetched =
+        std::any_of(m_prefetched_blocks.begin(), m_prefetched_blocks.end(),
+                    [&](const PrefetchedBlock& block) { return block.offset == offset; });
+    if (already_prefetched)
+      continue;
+
+    m_prefetched_blocks.push_back(
+        PrefetchedBlock{.partition = request.partition, .offset = offset});
+    // The blocks are handed out in turn, so the block that will be needed next is at the front of
+    // its thread's queue
+    m_prefetch_threads[m_next_prefetch_thread].Push(
+        PrefetchRequest{.partition = request.partition, .offset = offset, .size = block_size});
+    m_next_prefetch_thread = (m_next_prefetch_thread + 1) % m_prefetch_threads.size();
+  }
+}
+
+void DVDThread::PrefetchBlock(const PrefetchRequest& request)
+{
+  const auto find_block = [&] {
+    return std::find_if(m_prefetched_blocks.begin(), m_prefetched_blocks.end(),
+                        [&](const PrefetchedBlock& block) {
+                          return block.partition == request.partition &&
+                                 block.offset == request.offset;
+                        });
+  };
+
+  {
+    std::lock_guard lk(m_prefetch_mutex);
+    if (find_block() == m_prefetched_blocks.end())
+      return;
+  }
+
+  // ReadConcurrent doesn't disturb the state used by Read, so the DVD thread can keep reading
+  // while the block is loading. m_disc isn't replaced before this thread has become idle.
+  std::vector<u8> data(request.size);
+  if (!m_disc->ReadConcurrent(request.offset, request.size, data.data(), request.partition))
+    data.clear();
+
+  std::lock_guard lk(m_prefetch_mutex);
+  const auto it = find_block();
+  if (it == m_prefetched_blocks.end())
+    return;
+
+  it->data = std::move(data);
+  it->ready = true;
+  m_prefetch_cond.notify_all();
+}
+
+void DVDThread::DiscardPrefetches()
+{
+  {
+    std::lock_guard lk(m_prefetch_mutex);
+    m_prefetched_blocks.clear();
+  }
+
+  // Queued requests are skipped now that their blocks are gone, but reads that are in progress
+  // have to finish before m_disc can be replaced
+  for (auto& thread : m_prefetch_threads)
+    thread.WaitForCompletion();
+
+  m_last_read_partition = DiscIO::Partition{};
+  m_last_read_end = 0;
+  m_sequential_reads = 0;
+}
 }  // namespace DVD
@@ -3,8 +3,13 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <utility>
@@ -14,6 +19,7 @@
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/SPSCQueue.h"
+#include "Common/WorkQueueThread.h"
 
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/FileMonitor.h"
@@ -86,6 +92,11 @@ public:
                               const DiscIO::Partition& partition, DVD::ReplyType reply_type,
                               s64 ticks_until_completion);
 
+  // The number of times that emulation had to wait for the host to finish reading from the disc,
+  // and the total time spent waiting. Can be called from any thread.
+  u64 GetStallCount() const { return m_stall_count.load(std::memory_order_relaxed); }
+  u64 GetStallTimeUs() const { return m_stall_time_us.load(std::memory_order_relaxed); }
+
 private:
   void StartDVDThread();
   void StopDVDThread();
@@ -126,6 +137,35 @@ private:
 
   using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+  // How many blocks can be read ahead of time at once
+  static constexpr size_t PREFETCH_THREAD_COUNT = 4;
+
+  // A block of the disc that is being read ahead of time on a prefetch thread, because the
+  // emulated software has been reading sequentially and is likely to request the block soon
+  struct PrefetchedBlock
+  {
+    DiscIO::Partition partition{};
+    u64 offset = 0;
+    // Set by a prefetch thread once the read has finished. data is empty if the read failed.
+    bool ready = false;
+    std::vector<u8> data;
+    // Set once the block has been used for the first time
+    bool used = false;
+  };
+
+  struct PrefetchRequest
+  {
+    DiscIO::Partition partition{};
+    u64 offset = 0;
+    u64 size = 0;
+  };
+
+  std::vector<u8> ReadDisc(const ReadRequest& request);
+  bool ReadPrefetchedBlock(const ReadRequest& request, u8* buffer);
+  void UpdatePrefetches(const ReadRequest& request);
+  void PrefetchBlock(const PrefetchRequest& request);
+  void DiscardPrefetches();
+
   CoreTiming::EventType* m_finish_read = nullptr;
 
   u64 m_next_id = 0;
@@ -141,6 +181,25 @@ private:
 
   std::unique_ptr<DiscIO::Volume> m_disc;
 
+  // Blocks are only added and removed by the DVD thread, except that the CPU thread discards them
+  // (while the DVD thread is idle) before m_disc gets replaced. The prefetch threads only fill in
+  // blocks that are still in m_prefetched_blocks once they have read them. They're declared after
+  // m_disc and the blocks so that they're shut down before those are destroyed.
+  std::mutex m_prefetch_mutex;
+  std::condition_variable m_prefetch_cond;
+  std::deque<PrefetchedBlock> m_prefetched_blocks;
+  std::array<Common::WorkQueueThread<PrefetchRequest>, PREFETCH_THREAD_COUNT> m_prefetch_threads;
+  size_t m_next_prefetch_thread = 0;
+  DiscIO::Partition m_last_read_partition{};
+  u64 m_last_read_end = 0;
+  u32 m_sequential_reads = 0;
+  u64 m_prefetch_hits = 0;
+  u64 m_prefetch_late_hits = 0;
+  u64 m_prefetch_misses = 0;
+
+  std::atomic<u64> m_stall_count = 0;
+  std::atomic<u64> m_stall_time_us = 0;
+
   FileMonitor::FileLogger m_file_logger;
 
   Core::System& m_system;
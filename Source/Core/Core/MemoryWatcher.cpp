@@ -3,19 +3,31 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <unistd.h>
 
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
 
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
+  if (File::IsDirectory(File::GetUserPath(D_MEMORYWATCHER_IDX)))
+    OpenControlSocket(File::GetUserPath(F_MEMORYWATCHERCONTROLSOCKET_IDX));
+
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
   if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
@@ -25,6 +37,12 @@ MemoryWatcher::MemoryWatcher()
 
 MemoryWatcher::~MemoryWatcher()
 {
+  if (m_control_fd >= 0)
+  {
+    close(m_control_fd);
+    unlink(m_control_path.c_str());
+  }
+
   if (!m_running)
     return;
 
@@ -67,6 +85,48 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
+bool MemoryWatcher::OpenControlSocket(const std::string& path)
+{
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path))
+  {
+    ERROR_LOG_FMT(MEMMAP, "Memory watcher control socket path is too long: {}", path);
+    return false;
+  }
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+  const int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  if (fd < 0)
+    return false;
+
+  // Left behind if Dolphin didn't shut down cleanly
+  unlink(path.c_str());
+
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+  {
+    ERROR_LOG_FMT(MEMMAP, "Failed to bind memory watcher control socket {}: {}", path,
+                  strerror(errno));
+    close(fd);
+    return false;
+  }
+
+  // The default send buffer limits the size of datagrams on some systems, so try to raise it.
+  // Linux reports back twice the size that was set, since it counts bookkeeping overhead too.
+  int buffer_size = MAX_PACKET_SIZE;
+  setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+  socklen_t buffer_size_len = sizeof(buffer_size);
+  if (getsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, &buffer_size_len) == 0)
+  {
+    m_max_packet_size =
+        std::clamp<u32>(static_cast<u32>(buffer_size), MIN_PACKET_SIZE, MAX_PACKET_SIZE);
+  }
+
+  m_control_fd = fd;
+  m_control_path = path;
+  return true;
+}
+
 u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
 {
   u32 value = 0;
@@ -101,8 +161,218 @@ std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
   return message_stream.str();
 }
 
+void MemoryWatcher::ReceiveRequests()
+{
+  while (true)
+  {
+    Request request;
+    sockaddr_un client_addr{};
+    socklen_t client_addr_len = sizeof(client_addr);
+    const ssize_t size = recvfrom(m_control_fd, &request, sizeof(request), MSG_DONTWAIT,
+                                  reinterpret_cast<sockaddr*>(&client_addr), &client_addr_len);
+    if (size < 0)
+      return;
+
+    if (size != sizeof(request))
+    {
+      WARN_LOG_FMT(MEMMAP, "Memory watcher received a request of invalid size {}", size);
+      continue;
+    }
+
+    // Unbound sockets can't be replied to
+    if (client_addr_len > offsetof(sockaddr_un, sun_path) && client_addr.sun_path[0] != '\0')
+    {
+      m_client_addr = client_addr;
+      m_client_addr_len = client_addr_len;
+    }
+
+    HandleRequest(request);
+  }
+}
+
+void MemoryWatcher::HandleRequest(const Request& request)
+{
+  switch (request.type)
+  {
+  case RequestType::Watch:
+    if (request.size == 0 || request.size > GetMaxRangeSize())
+    {
+      WARN_LOG_FMT(MEMMAP, "Memory watcher can't watch {} bytes at {:08x}", request.size,
+                   request.address);
+      return;
+    }
+    if (m_ranges.size() >= MAX_WATCHED_RANGES && !m_ranges.contains(request.id))
+    {
+      WARN_LOG_FMT(MEMMAP, "Memory watcher can't watch more than {} ranges", MAX_WATCHED_RANGES);
+      return;
+    }
+    m_ranges.insert_or_assign(request.id,
+                              WatchedRange{request.address, std::vector<u8>(request.size)});
+    break;
+  case RequestType::Unwatch:
+    m_ranges.erase(request.id);
+    break;
+  case RequestType::UnwatchAll:
+    m_ranges.clear();
+    break;
+  default:
+    WARN_LOG_FMT(MEMMAP, "Memory watcher received an unknown request {}",
+                 static_cast<u32>(request.type));
+    break;
+  }
+}
+
+// Returns the host memory backing the given guest memory, or nullptr if it isn't contiguous RAM.
+static const u8* GetRangePointer(const Core::CPUThreadGuard& guard, u32 address, u32 size)
+{
+  auto& system = guard.GetSystem();
+  const u32 last_address = address + size - 1;
+  if (last_address < address)
+    return nullptr;
+
+  u32 physical_address = address;
+  if (system.GetPPCState().msr.DR)
+  {
+    auto& mmu = system.GetMMU();
+    const std::optional<u32> first = mmu.GetTranslatedAddress(address);
+    if (!first)
+      return nullptr;
+    physical_address = *first;
+
+    // Pages mapped through the page table don't have to be physically contiguous
+    for (u32 page = (address | PowerPC::HW_PAGE_MASK) + 1; page - 1 < last_address;
+         page += PowerPC::HW_PAGE_SIZE)
+    {
+      const std::optional<u32> translated = mmu.GetTranslatedAddress(page);
+      if (!translated || *translated - physical_address != page - address)
+        return nullptr;
+    }
+  }
+
+  auto& memory = system.GetMemory();
+  const u32 offset = physical_address & 0x0FFFFFFF;
+  switch (physical_address >> 28)
+  {
+  case 0:
+    if (offset + u64{size} <= memory.GetRamSizeReal())
+      return memory.GetRAM() + offset;
+    break;
+  case 1:
+    if (memory.GetEXRAM() && offset + u64{size} <= memory.GetExRamSizeReal())
+      return memory.GetEXRAM() + offset;
+    break;
+  }
+  return nullptr;
+}
+
+void MemoryWatcher::SendChangedRanges(const Core::CPUThreadGuard& guard)
+{
+  std::vector<u8> packet(sizeof(PacketHeader));
+  u32 num_events = 0;
+  bool sent = true;
+
+  for (auto it = m_ranges.begin(); it != m_ranges.end();)
+  {
+    const u32 id = it->first;
+    WatchedRange& range = it->second;
+    const u32 size = static_cast<u32>(range.value.size());
+
+    // The packet size limit may have been lowered after the range was watched
+    if (size > GetMaxRangeSize())
+    {
+      WARN_LOG_FMT(MEMMAP, "Memory watcher range at {:08x} no longer fits in a datagram",
+                   range.address);
+      it = m_ranges.erase(it);
+      continue;
+    }
+    ++it;
+
+    const u8* data = GetRangePointer(guard, range.address, size);
+    if (!data)
+      continue;
+    if (range.reported && std::memcmp(range.value.data(), data, size) == 0)
+      continue;
+
+    std::memcpy(range.value.data(), data, size);
+    range.reported = true;
+
+    if (packet.size() + sizeof(EventHeader) + size > m_max_packet_size)
+    {
+      sent = SendPacket(&packet, num_events);
+      if (!sent)
+        break;
+      num_events = 0;
+    }
+
+    const EventHeader event{id, range.address, size};
+    const u8* event_bytes = reinterpret_cast<const u8*>(&event);
+    packet.insert(packet.end(), event_bytes, event_bytes + sizeof(event));
+    packet.insert(packet.end(), range.value.begin(), range.value.end());
+    ++num_events;
+  }
+
+  if (sent && num_events != 0)
+    sent = SendPacket(&packet, num_events);
+
+  if (m_client_addr_len == 0)
+  {
+    // Stop doing work for clients that have gone away
+    m_ranges.clear();
+  }
+  else if (!sent)
+  {
+    // Some changes didn't make it to the client, so send the full state once it catches up
+    for (auto& [id, range] : m_ranges)
+      range.reported = false;
+  }
+}
+
+bool MemoryWatcher::SendPacket(std::vector<u8>* packet, u32 num_events)
+{
+  const PacketHeader header{PACKET_MAGIC, m_frame, num_events};
+  std::memcpy(packet->data(), &header, sizeof(header));
+
+  // Never block the CPU thread on a client that isn't keeping up
+  const ssize_t result =
+      sendto(m_control_fd, packet->data(), packet->size(), MSG_DONTWAIT,
+             reinterpret_cast<sockaddr*>(&m_client_addr), m_client_addr_len);
+  packet->resize(sizeof(header));
+  if (result >= 0)
+    return true;
+
+  if (errno == ECONNREFUSED || errno == ENOENT)
+  {
+    INFO_LOG_FMT(MEMMAP, "Memory watcher client disconnected");
+    m_client_addr_len = 0;
+  }
+  else if (errno == EMSGSIZE && m_max_packet_size > MIN_PACKET_SIZE)
+  {
+    // The send buffer size doesn't match the datagram size limit everywhere, so find it by trial
+    m_max_packet_size = std::max(m_max_packet_size / 2, MIN_PACKET_SIZE);
+    WARN_LOG_FMT(MEMMAP, "Memory watcher lowered its datagram size to {} bytes", m_max_packet_size);
+  }
+  else if (errno != EAGAIN && errno != EWOULDBLOCK)
+  {
+    WARN_LOG_FMT(MEMMAP, "Memory watcher failed to send changes: {}", strerror(errno));
+  }
+  return false;
+}
+
+u32 MemoryWatcher::GetMaxRangeSize() const
+{
+  return m_max_packet_size - sizeof(PacketHeader) - sizeof(EventHeader);
+}
+
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
 {
+  if (m_control_fd >= 0)
+  {
+    ReceiveRequests();
+    if (m_client_addr_len != 0)
+      SendChangedRanges(guard);
+    ++m_frame;
+  }
+
   if (!m_running)
     return;
 
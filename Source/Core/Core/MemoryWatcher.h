@@ -24,21 +24,90 @@ class CPUThreadGuard;
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// Programs that need to watch many addresses, or ones that change at runtime, can use the binary
+// protocol of the control socket instead. It's created next to the input file when the
+// MemoryWatcher directory exists. A client binds a unix datagram socket of its own and sends
+// Requests from it to the control socket. At the end of every frame, the ranges that changed since
+// the last frame are sent back to the client that sent the latest request, batched into as few
+// datagrams as possible. Each datagram is a PacketHeader followed by num_events events, each of
+// which is an EventHeader followed by the contents of the range exactly as they're stored in guest
+// memory. A range is also reported once right after it's watched. All header fields are in host
+// byte order.
+//
+// Datagrams are at most MAX_PACKET_SIZE bytes, but can be smaller when the system limits the size
+// of unix datagrams (macOS allows 2 KiB by default), which also limits the size of a range.
+// Ranges that fit in MIN_PACKET_SIZE are supported everywhere. Clients should make their receive
+// buffer large enough for MAX_PACKET_SIZE.
 class MemoryWatcher final
 {
 public:
+  enum class RequestType : u32
+  {
+    // Starts watching size bytes at address, replacing the range previously watched with that id
+    Watch = 0,
+    Unwatch = 1,
+    UnwatchAll = 2,
+  };
+
+  struct Request
+  {
+    RequestType type;
+    // Chosen by the client to tell the ranges apart in events
+    u32 id;
+    u32 address;
+    u32 size;
+  };
+
+  static constexpr u32 PACKET_MAGIC = 0x4D575331;  // "MWS1"
+  static constexpr u32 MIN_PACKET_SIZE = 0x800;
+  static constexpr u32 MAX_PACKET_SIZE = 0x10000;
+  static constexpr u32 MAX_WATCHED_RANGES = 0x1000;
+
+  struct PacketHeader
+  {
+    u32 magic;
+    // Counts the frames since emulation started
+    u32 frame;
+    u32 num_events;
+  };
+
+  struct EventHeader
+  {
+    u32 id;
+    u32 address;
+    u32 size;
+  };
+
+  static constexpr u32 MAX_RANGE_SIZE =
+      MAX_PACKET_SIZE - sizeof(PacketHeader) - sizeof(EventHeader);
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step(const Core::CPUThreadGuard& guard);
 
 private:
+  struct WatchedRange
+  {
+    u32 address;
+    std::vector<u8> value;
+    bool reported = false;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenControlSocket(const std::string& path);
 
   void ParseLine(const std::string& line);
   u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
   std::string ComposeMessages(const Core::CPUThreadGuard& guard);
 
+  void ReceiveRequests();
+  void HandleRequest(const Request& request);
+  void SendChangedRanges(const Core::CPUThreadGuard& guard);
+  bool SendPacket(std::vector<u8>* packet, u32 num_events);
+  u32 GetMaxRangeSize() const;
+
   bool m_running = false;
 
   int m_fd;
@@ -48,4 +117,15 @@ private:
   std::map<std::string, std::vector<u32>> m_addresses;
   // Address as stored in the file -> current value
   std::map<std::string, u32> m_values;
+
+  int m_control_fd = -1;
+  std::string m_control_path;
+  sockaddr_un m_client_addr{};
+  socklen_t m_client_addr_len = 0;
+  // Lowered from MAX_PACKET_SIZE to what the control socket can actually send
+  u32 m_max_packet_size = MIN_PACKET_SIZE;
+  u32 m_frame = 0;
+
+  // Client-chosen id -> watched range
+  std::map<u32, WatchedRange> m_ranges;
 };
@@ -203,6 +203,10 @@ void BreakPoints::ClearAllTemporary()
   }
 }
 
+// The granularity of MemChecks::m_watched_pages
+constexpr u32 WATCHED_PAGE_SHIFT = 12;
+constexpr size_t WATCHED_PAGE_COUNT = size_t(1) << (32 - WATCHED_PAGE_SHIFT);
+
 MemChecks::MemChecks(Core::System& system) : m_system(system)
 {
 }
@@ -289,6 +293,7 @@ void MemChecks::Add(TMemCheck memory_check)
     {
       m_mem_checks.emplace_back(std::move(memory_check));
     }
+    UpdateIndex();
     // If this is the first one, clear the JIT cache so it can switch to
     // watchpoint-compatible code.
     if (!had_any)
@@ -320,6 +325,7 @@ void MemChecks::Remove(u32 address)
 
   Core::RunAsCPUThread([&] {
     m_mem_checks.erase(iter);
+    UpdateIndex();
     if (!HasAny())
       m_system.GetJitInterface().ClearCache();
     m_system.GetMMU().DBATUpdated();
@@ -330,39 +336,103 @@ void MemChecks::Clear()
 {
   Core::RunAsCPUThread([&] {
     m_mem_checks.clear();
+    UpdateIndex();
     m_system.GetJitInterface().ClearCache();
     m_system.GetMMU().DBATUpdated();
   });
 }
 
-TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
+void MemChecks::UpdateIndex()
 {
-  const auto iter =
-      std::find_if(m_mem_checks.begin(), m_mem_checks.end(), [address, size](const auto& mc) {
-        return mc.end_address >= address && address + size - 1 >= mc.start_address;
-      });
+  m_watched_pages.clear();
+  m_index.clear();
 
-  // None found
-  if (iter == m_mem_checks.cend())
+  if (m_mem_checks.empty())
+    return;
+
+  m_watched_pages.resize(WATCHED_PAGE_COUNT / 64);
+  m_index.reserve(m_mem_checks.size());
+
+  for (size_t i = 0; i < m_mem_checks.size(); ++i)
+  {
+    const TMemCheck& mc = m_mem_checks[i];
+
+    const u32 first_page = std::min(mc.start_address, mc.end_address) >> WATCHED_PAGE_SHIFT;
+    const u32 last_page = std::max(mc.start_address, mc.end_address) >> WATCHED_PAGE_SHIFT;
+    for (u32 page = first_page; page <= last_page; ++page)
+      m_watched_pages[page / 64] |= u64(1) << (page % 64);
+
+    m_index.push_back({mc.start_address, mc.end_address, 0, i});
+  }
+
+  std::sort(m_index.begin(), m_index.end(), [](const IndexEntry& a, const IndexEntry& b) {
+    return a.start_address < b.start_address;
+  });
+
+  u32 max_end_address = 0;
+  for (IndexEntry& entry : m_index)
+  {
+    max_end_address = std::max(max_end_address, entry.end_address);
+    entry.max_end_address = max_end_address;
+  }
+}
+
+bool MemChecks::IsAnyPageWatched(u32 address, u32 last_address) const
+{
+  for (u32 page = address >> WATCHED_PAGE_SHIFT; page <= last_address >> WATCHED_PAGE_SHIFT; ++page)
+  {
+    if (m_watched_pages[page / 64] & (u64(1) << (page % 64)))
+      return true;
+  }
+
+  return false;
+}
+
+size_t MemChecks::FindMemCheck(u32 address, u32 last_address) const
+{
+  if (!HasAny())
+    return m_mem_checks.size();
+
+  // Ranges that wrap around the end of the address space skip the quick check
+  if (last_address >= address && !IsAnyPageWatched(address, last_address))
+    return m_mem_checks.size();
+
+  // Entries after the upper bound start too late to overlap. Going backwards from there, we can
+  // stop as soon as no earlier entry ends late enough to overlap.
+  auto it = std::upper_bound(
+      m_index.begin(), m_index.end(), last_address,
+      [](u32 value, const IndexEntry& entry) { return value < entry.start_address; });
+
+  // If several memchecks overlap, return the one that was added first, like a linear search would
+  size_t result = m_mem_checks.size();
+  while (it != m_index.begin())
+  {
+    --it;
+    if (it->max_end_address < address)
+      break;
+    if (it->end_address >= address)
+      result = std::min(result, it->mem_check_index);
+  }
+
+  return result;
+}
+
+TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
+{
+  const size_t index = FindMemCheck(address, static_cast<u32>(address + size - 1));
+  if (index == m_mem_checks.size())
     return nullptr;
 
-  return &*iter;
+  return &m_mem_checks[index];
 }
 
 bool MemChecks::OverlapsMemcheck(u32 address, u32 length) const
 {
-  if (!HasAny())
+  if (length == 0)
     return false;
 
-  const u32 page_end_suffix = length - 1;
-  const u32 page_end_address = address | page_end_suffix;
-
-  return std::any_of(m_mem_checks.cbegin(), m_mem_checks.cend(), [&](const auto& mc) {
-    return ((mc.start_address | page_end_suffix) == page_end_address ||
-            (mc.end_address | page_end_suffix) == page_end_address) ||
-           ((mc.start_address | page_end_suffix) < page_end_address &&
-            (mc.end_address | page_end_suffix) > page_end_address);
-  });
+  const u32 last_address = static_cast<u32>(std::min<u64>(u64(address) + length - 1, UINT32_MAX));
+  return FindMemCheck(address, last_address) != m_mem_checks.size();
 }
 
 bool TMemCheck::Action(Core::System& system, Core::DebugInterface* debug_interface, u64 value,
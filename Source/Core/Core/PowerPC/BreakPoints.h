@@ -127,6 +127,29 @@ public:
   bool HasAny() const { return !m_mem_checks.empty(); }
 
 private:
+  struct IndexEntry
+  {
+    u32 start_address;
+    u32 end_address;
+    // The largest end_address of this entry and all entries before it
+    u32 max_end_address;
+    size_t mem_check_index;
+  };
+
+  // Must be called whenever the address ranges in m_mem_checks change.
+  void UpdateIndex();
+  bool IsAnyPageWatched(u32 address, u32 last_address) const;
+  // Returns the index of the first added memcheck that overlaps the range, or the number of
+  // memchecks if there is none
+  size_t FindMemCheck(u32 address, u32 last_address) const;
+
   TMemChecks m_mem_checks;
+
+  // One bit for each page of the address space, set if any memcheck overlaps the page. Lets
+  // FindMemCheck return early for the vast majority of accesses, which don't hit any memcheck.
+  std::vector<u64> m_watched_pages;
+  // The memchecks sorted by start address, so that GetMemCheck can binary search them
+  std::vector<IndexEntry> m_index;
+
   Core::System& m_system;
 };
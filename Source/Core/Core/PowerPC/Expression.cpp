@@ -4,6 +4,8 @@
 #include "Core/PowerPC/Expression.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdlib>
 #include <fmt/format.h>
 #include <optional>
@@ -203,6 +205,43 @@ static std::array<expr_func, 23> g_expr_funcs{{
     {},
 }};
 
+template <typename T, typename U = T>
+static double CompiledHostRead(const Core::CPUThreadGuard& guard, u32 address)
+{
+  return Common::BitCast<T>(HostRead<U>(guard, address));
+}
+
+template <typename T, typename U = T>
+static double CompiledCast(double value)
+{
+  return Common::BitCast<T>(static_cast<U>(value));
+}
+
+struct CompiledFunction
+{
+  std::string_view name;
+  double (*call)(double);
+  double (*read)(const Core::CPUThreadGuard& guard, u32 address);
+};
+
+// The functions from g_expr_funcs which take one number and have no side effects
+static const std::array<CompiledFunction, 14> s_compiled_funcs{{
+    {"read_u8", nullptr, CompiledHostRead<u8>},
+    {"read_s8", nullptr, CompiledHostRead<s8, u8>},
+    {"read_u16", nullptr, CompiledHostRead<u16>},
+    {"read_s16", nullptr, CompiledHostRead<s16, u16>},
+    {"read_u32", nullptr, CompiledHostRead<u32>},
+    {"read_s32", nullptr, CompiledHostRead<s32, u32>},
+    {"read_f32", nullptr, CompiledHostRead<float, u32>},
+    {"read_f64", nullptr, CompiledHostRead<double, u64>},
+    {"u8", CompiledCast<u8>, nullptr},
+    {"s8", CompiledCast<s8, u8>, nullptr},
+    {"u16", CompiledCast<u16>, nullptr},
+    {"s16", CompiledCast<s16, u16>, nullptr},
+    {"u32", CompiledCast<u32>, nullptr},
+    {"s32", CompiledCast<s32, u32>, nullptr},
+}};
+
 void ExprDeleter::operator()(expr* expression) const
 {
   expr_destroy(expression, nullptr);
@@ -254,6 +293,342 @@ Expression::Expression(std::string_view text, ExprPointer ex, ExprVarListPointer
 
     m_binds.emplace_back(bind);
   }
+
+  if (!Compile(m_expr.get(), 0))
+  {
+    m_program.clear();
+    m_program_reads_memory = false;
+  }
+}
+
+bool Expression::Compile(const expr* e, size_t depth)
+{
+  if (depth >= MAX_STACK_DEPTH)
+    return false;
+
+  const auto arg = [e](int i) { return &vec_nth(&e->param.op.args, i); };
+  const auto emit = [this](Opcode opcode) {
+    m_program.push_back(Instruction{opcode});
+    return true;
+  };
+  const auto unary = [&](Opcode opcode) { return Compile(arg(0), depth) && emit(opcode); };
+  const auto binary = [&](Opcode opcode) {
+    return Compile(arg(0), depth) && Compile(arg(1), depth + 1) && emit(opcode);
+  };
+
+  switch (e->type)
+  {
+  case OP_CONST:
+    m_program.push_back(Instruction{Opcode::Constant, 0, e->param.num.value});
+    return true;
+
+  case OP_VAR:
+  {
+    auto bind = m_binds.begin();
+    for (auto* v = m_vars->head; v != nullptr; v = v->next, ++bind)
+    {
+      if (&v->value != e->param.var.value)
+        continue;
+
+      switch (bind->type)
+      {
+      case VarBindingType::Zero:
+        m_program.push_back(Instruction{Opcode::Constant});
+        return true;
+      case VarBindingType::GPR:
+        m_program.push_back(Instruction{Opcode::GPR, static_cast<u32>(bind->index)});
+        return true;
+      case VarBindingType::FPR:
+        m_program.push_back(Instruction{Opcode::FPR, static_cast<u32>(bind->index)});
+        return true;
+      case VarBindingType::SPR:
+        m_program.push_back(Instruction{Opcode::SPR, static_cast<u32>(bind->index)});
+        return true;
+      case VarBindingType::PCtr:
+        return emit(Opcode::PCtr);
+      }
+    }
+    return false;
+  }
+
+  case OP_UNARY_MINUS:
+    return unary(Opcode::Negate);
+  case OP_UNARY_LOGICAL_NOT:
+    return unary(Opcode::LogicalNot);
+  case OP_UNARY_BITWISE_NOT:
+    return unary(Opcode::BitwiseNot);
+  case OP_POWER:
+    return binary(Opcode::Power);
+  case OP_DIVIDE:
+    return binary(Opcode::Divide);
+  case OP_MULTIPLY:
+    return binary(Opcode::Multiply);
+  case OP_REMAINDER:
+    return binary(Opcode::Remainder);
+  case OP_PLUS:
+    return binary(Opcode::Plus);
+  case OP_MINUS:
+    return binary(Opcode::Minus);
+  case OP_SHL:
+    return binary(Opcode::ShiftLeft);
+  case OP_SHR:
+    return binary(Opcode::ShiftRight);
+  case OP_LT:
+    return binary(Opcode::Less);
+  case OP_LE:
+    return binary(Opcode::LessEqual);
+  case OP_GT:
+    return binary(Opcode::Greater);
+  case OP_GE:
+    return binary(Opcode::GreaterEqual);
+  case OP_EQ:
+    return binary(Opcode::Equal);
+  case OP_NE:
+    return binary(Opcode::NotEqual);
+  case OP_BITWISE_AND:
+    return binary(Opcode::BitwiseAnd);
+  case OP_BITWISE_OR:
+    return binary(Opcode::BitwiseOr);
+  case OP_BITWISE_XOR:
+    return binary(Opcode::BitwiseXor);
+
+  case OP_LOGICAL_AND:
+  case OP_LOGICAL_OR:
+  {
+    if (!Compile(arg(0), depth))
+      return false;
+
+    const size_t jump_index = m_program.size();
+    emit(e->type == OP_LOGICAL_AND ? Opcode::LogicalAndJump : Opcode::LogicalOrJump);
+
+    if (!Compile(arg(1), depth))
+      return false;
+    emit(Opcode::LogicalResult);
+
+    m_program[jump_index].index = static_cast<u32>(m_program.size());
+    return true;
+  }
+
+  case OP_COMMA:
+    return Compile(arg(0), depth) && emit(Opcode::Pop) && Compile(arg(1), depth);
+
+  case OP_FUNC:
+  {
+    const std::string_view name = e->param.func.f->name;
+    const auto func = std::find_if(s_compiled_funcs.begin(), s_compiled_funcs.end(),
+                                   [name](const CompiledFunction& f) { return f.name == name; });
+    if (func == s_compiled_funcs.end() || vec_len(&e->param.func.args) != 1)
+      return false;
+
+    if (!Compile(&vec_nth(&e->param.func.args, 0), depth))
+      return false;
+
+    Instruction instruction{func->read ? Opcode::Read : Opcode::Call};
+    instruction.call = func->call;
+    instruction.read = func->read;
+    m_program.push_back(instruction);
+
+    if (func->read)
+      m_program_reads_memory = true;
+    return true;
+  }
+
+  default:
+    // Assignments and strings
+    return false;
+  }
+}
+
+double Expression::Run(Core::System& system, bool* loaded_nan) const
+{
+  const auto& ppc_state = system.GetPPCState();
+
+  std::optional<Core::CPUThreadGuard> guard;
+  if (m_program_reads_memory)
+    guard.emplace(system);
+
+  std::array<double, MAX_STACK_DEPTH> stack;
+  size_t sp = 0;
+
+  for (size_t i = 0; i < m_program.size(); ++i)
+  {
+    const Instruction& instruction = m_program[i];
+
+    // For binary operators. Pops the right operand and returns it along with the left operand.
+    const auto operands = [&] {
+      --sp;
+      return std::pair<double&, double>(stack[sp - 1], stack[sp]);
+    };
+
+    switch (instruction.opcode)
+    {
+    case Opcode::Constant:
+      stack[sp++] = instruction.value;
+      break;
+    case Opcode::GPR:
+      stack[sp++] = static_cast<double>(ppc_state.gpr[instruction.index]);
+      break;
+    case Opcode::FPR:
+      stack[sp] = ppc_state.ps[instruction.index].PS0AsDouble();
+      if (std::isnan(stack[sp]))
+        *loaded_nan = true;
+      ++sp;
+      break;
+    case Opcode::SPR:
+      stack[sp++] = static_cast<double>(ppc_state.spr[instruction.index]);
+      break;
+    case Opcode::PCtr:
+      stack[sp++] = static_cast<double>(ppc_state.pc);
+      break;
+
+    case Opcode::Negate:
+      stack[sp - 1] = -stack[sp - 1];
+      break;
+    case Opcode::LogicalNot:
+      stack[sp - 1] = !stack[sp - 1];
+      break;
+    case Opcode::BitwiseNot:
+      stack[sp - 1] = static_cast<double>(~to_int(stack[sp - 1]));
+      break;
+
+    case Opcode::Power:
+    {
+      auto [a, b] = operands();
+      a = std::pow(a, b);
+      break;
+    }
+    case Opcode::Divide:
+    {
+      auto [a, b] = operands();
+      a = a / b;
+      break;
+    }
+    case Opcode::Multiply:
+    {
+      auto [a, b] = operands();
+      a = a * b;
+      break;
+    }
+    case Opcode::Remainder:
+    {
+      auto [a, b] = operands();
+      a = std::fmod(a, b);
+      break;
+    }
+    case Opcode::Plus:
+    {
+      auto [a, b] = operands();
+      a = a + b;
+      break;
+    }
+    case Opcode::Minus:
+    {
+      auto [a, b] = operands();
+      a = a - b;
+      break;
+    }
+    case Opcode::ShiftLeft:
+    {
+      auto [a, b] = operands();
+      a = static_cast<double>(to_int(a) << to_int(b));
+      break;
+    }
+    case Opcode::ShiftRight:
+    {
+      auto [a, b] = operands();
+      a = static_cast<double>(to_int(a) >> to_int(b));
+      break;
+    }
+    case Opcode::Less:
+    {
+      auto [a, b] = operands();
+      a = a < b;
+      break;
+    }
+    case Opcode::LessEqual:
+    {
+      auto [a, b] = operands();
+      a = a <= b;
+      break;
+    }
+    case Opcode::Greater:
+    {
+      auto [a, b] = operands();
+      a = a > b;
+      break;
+    }
+    case Opcode::GreaterEqual:
+    {
+      auto [a, b] = operands();
+      a = a >= b;
+      break;
+    }
+    case Opcode::Equal:
+    {
+      auto [a, b] = operands();
+      a = a == b;
+      break;
+    }
+    case Opcode::NotEqual:
+    {
+      auto [a, b] = operands();
+      a = a != b;
+      break;
+    }
+    case Opcode::BitwiseAnd:
+    {
+      auto [a, b] = operands();
+      a = static_cast<double>(to_int(a) & to_int(b));
+      break;
+    }
+    case Opcode::BitwiseOr:
+    {
+      auto [a, b] = operands();
+      a = static_cast<double>(to_int(a) | to_int(b));
+      break;
+    }
+    case Opcode::BitwiseXor:
+    {
+      auto [a, b] = operands();
+      a = static_cast<double>(to_int(a) ^ to_int(b));
+      break;
+    }
+
+    case Opcode::LogicalAndJump:
+      if (stack[sp - 1] == 0)
+      {
+        stack[sp - 1] = 0;
+        i = instruction.index - 1;
+      }
+      else
+      {
+        --sp;
+      }
+      break;
+    case Opcode::LogicalOrJump:
+      if (stack[sp - 1] != 0 && !std::isnan(stack[sp - 1]))
+        i = instruction.index - 1;
+      else
+        --sp;
+      break;
+    case Opcode::LogicalResult:
+      if (stack[sp - 1] == 0)
+        stack[sp - 1] = 0;
+      break;
+    case Opcode::Pop:
+      --sp;
+      break;
+
+    case Opcode::Call:
+      stack[sp - 1] = instruction.call(stack[sp - 1]);
+      break;
+    case Opcode::Read:
+      stack[sp - 1] = instruction.read(*guard, static_cast<u32>(stack[sp - 1]));
+      break;
+    }
+  }
+
+  return stack[0];
 }
 
 std::optional<Expression> Expression::TryParse(std::string_view text)
@@ -268,6 +643,21 @@ std::optional<Expression> Expression::TryParse(std::string_view text)
 
 double Expression::Evaluate(Core::System& system) const
 {
+  if (!m_program.empty())
+  {
+    bool loaded_nan = false;
+    const double result = Run(system, &loaded_nan);
+
+    // The variables are only used for reporting here, and nothing is reported for most evaluations
+    if (result != 0.0 || loaded_nan)
+    {
+      SynchronizeBindings(system, SynchronizeDirection::From);
+      Reporting(result);
+    }
+
+    return result;
+  }
+
   SynchronizeBindings(system, SynchronizeDirection::From);
 
   double result = expr_eval(m_expr.get());
@@ -320,15 +710,16 @@ void Expression::SynchronizeBindings(Core::System& system, SynchronizeDirection
 void Expression::Reporting(const double result) const
 {
   bool is_nan = std::isnan(result);
-  std::string message;
+  for (auto* v = m_vars->head; v != nullptr && !is_nan; v = v->next)
+    is_nan = std::isnan(v->value);
 
-  for (auto* v = m_vars->head; v != nullptr; v = v->next)
-  {
-    if (std::isnan(v->value))
-      is_nan = true;
+  // Most evaluations end up here, so avoid formatting anything
+  if (result == 0.0 && !is_nan)
+    return;
 
+  std::string message;
+  for (auto* v = m_vars->head; v != nullptr; v = v->next)
     fmt::format_to(std::back_inserter(message), "  {}={}", v->name, v->value);
-  }
 
   if (is_nan)
   {
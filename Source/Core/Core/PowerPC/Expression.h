@@ -9,6 +9,8 @@
 #include <string_view>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+
 struct expr;
 struct expr_var_list;
 
@@ -63,8 +65,66 @@ private:
     int index = -1;
   };
 
+  enum class Opcode : u8
+  {
+    Constant,
+    GPR,
+    FPR,
+    SPR,
+    PCtr,
+    Negate,
+    LogicalNot,
+    BitwiseNot,
+    Power,
+    Divide,
+    Multiply,
+    Remainder,
+    Plus,
+    Minus,
+    ShiftLeft,
+    ShiftRight,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    BitwiseAnd,
+    BitwiseOr,
+    BitwiseXor,
+    // Pops the left operand. If it decides the result, pushes the result and jumps to target.
+    LogicalAndJump,
+    LogicalOrJump,
+    // Replaces the right operand of && or || with the result of the operation.
+    LogicalResult,
+    // Drops the left operand of a comma.
+    Pop,
+    Call,
+    Read,
+  };
+
+  struct Instruction
+  {
+    Opcode opcode;
+    // The register index for GPR, FPR and SPR, the jump target for LogicalAndJump and
+    // LogicalOrJump
+    u32 index = 0;
+    double value = 0;
+    double (*call)(double) = nullptr;
+    double (*read)(const Core::CPUThreadGuard& guard, u32 address) = nullptr;
+  };
+
+  // Conditions are typically evaluated every time some instruction or memory access is hit, so
+  // they're compiled into a flat program where possible. Unlike the expr tree, the program reads
+  // registers directly and doesn't need the variables to be synchronized.
+  static constexpr size_t MAX_STACK_DEPTH = 32;
+
   Expression(std::string_view text, ExprPointer ex, ExprVarListPointer vars);
 
+  bool Compile(const expr* e, size_t depth);
+  // Sets *loaded_nan if a register that was read held a NaN
+  double Run(Core::System& system, bool* loaded_nan) const;
+
   void SynchronizeBindings(Core::System& system, SynchronizeDirection dir) const;
   void Reporting(const double result) const;
 
@@ -72,6 +132,10 @@ private:
   ExprPointer m_expr;
   ExprVarListPointer m_vars;
   std::vector<VarBinding> m_binds;
+  // Empty if the expression uses features that can't be compiled, such as assignments, functions
+  // with side effects, or strings. The expr tree is evaluated instead in that case.
+  std::vector<Instruction> m_program;
+  bool m_program_reads_memory = false;
 };
 
 inline bool EvaluateCondition(Core::System& system, const std::optional<Expression>& condition)
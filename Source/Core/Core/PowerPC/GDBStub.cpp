@@ -5,12 +5,16 @@
 
 #include "Core/PowerPC/GDBStub.h"
 
+#include <algorithm>
+#include <cctype>
 #include <fmt/format.h>
 #include <optional>
 #include <signal.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <string>
+#include <string_view>
 #ifdef _WIN32
 #include <WinSock2.h>
 #include <iphlpapi.h>
@@ -44,12 +48,13 @@ namespace GDBStub
 {
 static std::optional<Common::SocketContext> s_socket_context;
 
-#define GDB_BFR_MAX 10000
+#define GDB_BFR_MAX 0x10000
 
 #define GDB_STUB_START '$'
 #define GDB_STUB_END '#'
 #define GDB_STUB_ACK '+'
 #define GDB_STUB_NAK '-'
+#define GDB_STUB_ESCAPE '}'
 
 // We are treating software breakpoints and hardware breakpoints the same way
 enum class BreakpointType
@@ -70,6 +75,9 @@ const s64 GDB_UPDATE_CYCLES = 100000;
 
 static bool s_has_control = false;
 static bool s_just_connected = false;
+// Whether the client expects replies to 'x' packets to start with 'b', as GDB does. LLDB, which
+// introduced the packet, expects the data right away.
+static bool s_binary_upload = false;
 
 static int s_tmpsock = -1;
 static int s_sock = -1;
@@ -126,6 +134,65 @@ static void Hex2mem(u8* dst, u8* src, u32 len)
   }
 }
 
+// Binary data in packets escapes the characters that delimit packets, as well as '*' since it
+// starts a run-length encoded sequence in replies.
+static bool NeedsEscaping(u8 c)
+{
+  return c == GDB_STUB_START || c == GDB_STUB_END || c == GDB_STUB_ESCAPE || c == '*';
+}
+
+// Appends as much of the data as fits within max_size characters and returns how many bytes of
+// the data were appended.
+static u32 AppendEscapedBinary(std::string* dst, const u8* src, u32 len, size_t max_size)
+{
+  u32 i = 0;
+  for (; i < len; ++i)
+  {
+    const u8 c = src[i];
+    const size_t encoded_size = NeedsEscaping(c) ? 2 : 1;
+    if (dst->size() + encoded_size > max_size)
+      break;
+
+    if (encoded_size == 2)
+    {
+      dst->push_back(GDB_STUB_ESCAPE);
+      dst->push_back(static_cast<char>(c ^ 0x20));
+    }
+    else
+    {
+      dst->push_back(static_cast<char>(c));
+    }
+  }
+  return i;
+}
+
+// Returns the number of bytes written to dst, which is at most len.
+static u32 UnescapeBinary(u8* dst, const u8* src, const u8* src_end, u32 len)
+{
+  u32 written = 0;
+  while (written < len && src < src_end)
+  {
+    u8 c = *src++;
+    if (c == GDB_STUB_ESCAPE)
+    {
+      if (src == src_end)
+        break;
+      c = *src++ ^ 0x20;
+    }
+    dst[written++] = c;
+  }
+  return written;
+}
+
+// Parses a hex number starting at s_cmd_bfr[*i], leaving *i at the first character after it
+static u32 ReadHexNumber(u32* i)
+{
+  u32 value = 0;
+  while (*i < s_cmd_len && isxdigit(s_cmd_bfr[*i]))
+    value = (value << 4) | Hex2char(s_cmd_bfr[(*i)++]);
+  return value;
+}
+
 static void UpdateCallback(Core::System& system, u64 userdata, s64 cycles_late)
 {
   ProcessCommands(false);
@@ -279,18 +346,21 @@ static bool IsDataAvailable()
   return false;
 }
 
-static void SendReply(const char* reply)
+static void SendReply(std::string_view reply)
 {
   if (!IsActive())
     return;
 
   memset(s_cmd_bfr, 0, sizeof s_cmd_bfr);
 
-  s_cmd_len = (u32)strlen(reply);
+  s_cmd_len = (u32)reply.size();
   if (s_cmd_len + 4 > sizeof s_cmd_bfr)
+  {
     ERROR_LOG_FMT(GDB_STUB, "cmd_bfr overflow in gdb_reply");
+    return SendReply("E01");
+  }
 
-  memcpy(s_cmd_bfr + 1, reply, s_cmd_len);
+  memcpy(s_cmd_bfr + 1, reply.data(), s_cmd_len);
 
   s_cmd_len++;
   const u8 chk = CalculateChecksum();
@@ -325,6 +395,80 @@ static void WriteHostInfo()
           .c_str());
 }
 
+static std::string GetTargetDescription()
+{
+  // Without any features, GDB uses its own register layout for the architecture, which is the one
+  // ReadRegister and WriteRegister implement.
+  return "<?xml version=\"1.0\"?>\n"
+         "<!DOCTYPE target SYSTEM \"gdb-target.dtd\">\n"
+         "<target version=\"1.0\">\n"
+         "  <architecture>powerpc:750</architecture>\n"
+         "</target>\n";
+}
+
+// Handles qXfer:<object>:read:<annex>:<offset>,<length>
+static void HandleXferRead(std::string_view object, std::string_view annex, u32 offset,
+                           u32 length)
+{
+  std::string document;
+  if (object == "features" && annex == "target.xml")
+    document = GetTargetDescription();
+  else
+    return SendReply("E00");
+
+  if (offset >= document.size())
+    return SendReply("l");
+
+  std::string reply = "m";
+  const u32 available = static_cast<u32>(document.size() - offset);
+  const u32 max_size = std::min<u32>(length + 1, GDB_BFR_MAX - 4);
+  const u8* data = reinterpret_cast<const u8*>(document.data()) + offset;
+  const u32 sent = AppendEscapedBinary(&reply, data, std::min(length, available), max_size);
+  if (sent == available)
+    reply[0] = 'l';
+  SendReply(reply);
+}
+
+static void HandleXfer()
+{
+  // qXfer:object:read:annex:offset,length
+  const std::string_view command(CommandBufferAsString(), s_cmd_len);
+  const size_t object_start = strlen("qXfer:");
+  const size_t object_end = command.find(':', object_start);
+  if (object_end == std::string_view::npos ||
+      command.substr(object_end + 1, strlen("read:")) != "read:")
+  {
+    return SendReply("");
+  }
+
+  const size_t annex_start = object_end + 1 + strlen("read:");
+  const size_t annex_end = command.find(':', annex_start);
+  if (annex_end == std::string_view::npos)
+    return SendReply("E00");
+
+  u32 i = static_cast<u32>(annex_end + 1);
+  const u32 offset = ReadHexNumber(&i);
+  if (i >= s_cmd_len || s_cmd_bfr[i] != ',')
+    return SendReply("E00");
+  ++i;
+  const u32 length = ReadHexNumber(&i);
+
+  HandleXferRead(command.substr(object_start, object_end - object_start),
+                 command.substr(annex_start, annex_end - annex_start), offset, length);
+}
+
+static void HandleSupported()
+{
+  const std::string_view command(CommandBufferAsString(), s_cmd_len);
+  s_binary_upload = command.find("binary-upload+") != std::string_view::npos;
+
+  // PacketSize excludes the framing characters and the checksum. No memory map is advertised,
+  // since GDB refuses to access any address that isn't listed in it, and what's accessible
+  // depends on the MMU state (locked L1, MMIO, fake VMEM, page tables).
+  SendReply(fmt::format("swbreak+;hwbreak+;PacketSize={:x};qXfer:features:read+{}",
+                        GDB_BFR_MAX - 4, s_binary_upload ? ";binary-upload+" : ""));
+}
+
 static void HandleQuery()
 {
   DEBUG_LOG_FMT(GDB_STUB, "gdb: query '{}'", CommandBufferAsString());
@@ -342,7 +486,9 @@ static void HandleQuery()
   else if (!strncmp((const char*)(s_cmd_bfr), "qHostInfo", strlen("qHostInfo")))
     return WriteHostInfo();
   else if (!strncmp((const char*)(s_cmd_bfr), "qSupported", strlen("qSupported")))
-    return SendReply("swbreak+;hwbreak+");
+    return HandleSupported();
+  else if (!strncmp((const char*)(s_cmd_bfr), "qXfer:", strlen("qXfer:")))
+    return HandleXfer();
 
   SendReply("");
 }
@@ -363,18 +509,20 @@ static void HandleIsThreadAlive()
   SendReply("E01");
 }
 
-static void wbe32hex(u8* p, u32 v)
+static u32 wbe32hex(u8* p, u32 v)
 {
   u32 i;
   for (i = 0; i < 8; i++)
     p[i] = Nibble2hex(v >> (28 - 4 * i));
+  return 8;
 }
 
-static void wbe64hex(u8* p, u64 v)
+static u32 wbe64hex(u8* p, u64 v)
 {
   u32 i;
   for (i = 0; i < 16; i++)
     p[i] = Nibble2hex(v >> (60 - 4 * i));
+  return 16;
 }
 
 static u32 re32hex(u8* p)
@@ -399,243 +547,177 @@ static u64 re64hex(u8* p)
   return res;
 }
 
-static void ReadRegister()
+// Writes the register in hex to dst and returns the number of characters written, or 0 if the
+// register doesn't exist.
+static u32 WriteRegisterHex(u8* dst, u32 id)
 {
   auto& system = Core::System::GetInstance();
   auto& ppc_state = system.GetPPCState();
 
-  static u8 reply[64];
-  u32 id;
-
-  memset(reply, 0, sizeof reply);
-  id = Hex2char(s_cmd_bfr[1]);
-  if (s_cmd_bfr[2] != '\0')
-  {
-    id <<= 4;
-    id |= Hex2char(s_cmd_bfr[2]);
-  }
-
   if (id < 32)
   {
-    wbe32hex(reply, ppc_state.gpr[id]);
+    return wbe32hex(dst, ppc_state.gpr[id]);
   }
   else if (id >= 32 && id < 64)
   {
-    wbe64hex(reply, ppc_state.ps[id - 32].PS0AsU64());
+    return wbe64hex(dst, ppc_state.ps[id - 32].PS0AsU64());
   }
   else if (id >= 71 && id < 87)
   {
-    wbe32hex(reply, ppc_state.sr[id - 71]);
+    return wbe32hex(dst, ppc_state.sr[id - 71]);
   }
   else if (id >= 88 && id < 104)
   {
-    wbe32hex(reply, ppc_state.spr[SPR_IBAT0U + id - 88]);
+    return wbe32hex(dst, ppc_state.spr[SPR_IBAT0U + id - 88]);
   }
   else
   {
     switch (id)
     {
     case 64:
-      wbe32hex(reply, ppc_state.pc);
-      break;
+      return wbe32hex(dst, ppc_state.pc);
     case 65:
-      wbe32hex(reply, ppc_state.msr.Hex);
-      break;
+      return wbe32hex(dst, ppc_state.msr.Hex);
     case 66:
-      wbe32hex(reply, ppc_state.cr.Get());
-      break;
+      return wbe32hex(dst, ppc_state.cr.Get());
     case 67:
-      wbe32hex(reply, LR(ppc_state));
-      break;
+      return wbe32hex(dst, LR(ppc_state));
     case 68:
-      wbe32hex(reply, CTR(ppc_state));
-      break;
+      return wbe32hex(dst, CTR(ppc_state));
     case 69:
-      wbe32hex(reply, ppc_state.spr[SPR_XER]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_XER]);
     case 70:
-      wbe32hex(reply, ppc_state.fpscr.Hex);
-      break;
+      return wbe32hex(dst, ppc_state.fpscr.Hex);
     case 87:
-      wbe32hex(reply, ppc_state.spr[SPR_PVR]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_PVR]);
     case 104:
-      wbe32hex(reply, ppc_state.spr[SPR_SDR]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_SDR]);
     case 105:
-      wbe64hex(reply, ppc_state.spr[SPR_ASR]);
-      break;
+      return wbe64hex(dst, ppc_state.spr[SPR_ASR]);
     case 106:
-      wbe32hex(reply, ppc_state.spr[SPR_DAR]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_DAR]);
     case 107:
-      wbe32hex(reply, ppc_state.spr[SPR_DSISR]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_DSISR]);
     case 108:
-      wbe32hex(reply, ppc_state.spr[SPR_SPRG0]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_SPRG0]);
     case 109:
-      wbe32hex(reply, ppc_state.spr[SPR_SPRG1]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_SPRG1]);
     case 110:
-      wbe32hex(reply, ppc_state.spr[SPR_SPRG2]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_SPRG2]);
     case 111:
-      wbe32hex(reply, ppc_state.spr[SPR_SPRG3]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_SPRG3]);
     case 112:
-      wbe32hex(reply, ppc_state.spr[SPR_SRR0]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_SRR0]);
     case 113:
-      wbe32hex(reply, ppc_state.spr[SPR_SRR1]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_SRR1]);
     case 114:
-      wbe32hex(reply, ppc_state.spr[SPR_TL]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_TL]);
     case 115:
-      wbe32hex(reply, ppc_state.spr[SPR_TU]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_TU]);
     case 116:
-      wbe32hex(reply, ppc_state.spr[SPR_DEC]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_DEC]);
     case 117:
-      wbe32hex(reply, ppc_state.spr[SPR_DABR]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_DABR]);
     case 118:
-      wbe32hex(reply, ppc_state.spr[SPR_EAR]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_EAR]);
     case 119:
-      wbe32hex(reply, ppc_state.spr[SPR_HID0]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_HID0]);
     case 120:
-      wbe32hex(reply, ppc_state.spr[SPR_HID1]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_HID1]);
     case 121:
-      wbe32hex(reply, ppc_state.spr[SPR_IABR]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_IABR]);
     case 122:
-      wbe32hex(reply, ppc_state.spr[SPR_DABR]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_DABR]);
     case 124:
-      wbe32hex(reply, ppc_state.spr[SPR_UMMCR0]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_UMMCR0]);
     case 125:
-      wbe32hex(reply, ppc_state.spr[SPR_UPMC1]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_UPMC1]);
     case 126:
-      wbe32hex(reply, ppc_state.spr[SPR_UPMC2]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_UPMC2]);
     case 127:
-      wbe32hex(reply, ppc_state.spr[SPR_USIA]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_USIA]);
     case 128:
-      wbe32hex(reply, ppc_state.spr[SPR_UMMCR1]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_UMMCR1]);
     case 129:
-      wbe32hex(reply, ppc_state.spr[SPR_UPMC3]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_UPMC3]);
     case 130:
-      wbe32hex(reply, ppc_state.spr[SPR_UPMC4]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_UPMC4]);
     case 131:
-      wbe32hex(reply, ppc_state.spr[SPR_MMCR0]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_MMCR0]);
     case 132:
-      wbe32hex(reply, ppc_state.spr[SPR_PMC1]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_PMC1]);
     case 133:
-      wbe32hex(reply, ppc_state.spr[SPR_PMC2]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_PMC2]);
     case 134:
-      wbe32hex(reply, ppc_state.spr[SPR_SIA]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_SIA]);
     case 135:
-      wbe32hex(reply, ppc_state.spr[SPR_MMCR1]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_MMCR1]);
     case 136:
-      wbe32hex(reply, ppc_state.spr[SPR_PMC3]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_PMC3]);
     case 137:
-      wbe32hex(reply, ppc_state.spr[SPR_PMC4]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_PMC4]);
     case 138:
-      wbe32hex(reply, ppc_state.spr[SPR_L2CR]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_L2CR]);
     case 139:
-      wbe32hex(reply, ppc_state.spr[SPR_ICTC]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_ICTC]);
     case 140:
-      wbe32hex(reply, ppc_state.spr[SPR_THRM1]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_THRM1]);
     case 141:
-      wbe32hex(reply, ppc_state.spr[SPR_THRM2]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_THRM2]);
     case 142:
-      wbe32hex(reply, ppc_state.spr[SPR_THRM3]);
-      break;
+      return wbe32hex(dst, ppc_state.spr[SPR_THRM3]);
     default:
-      return SendReply("E01");
-      break;
+      return 0;
     }
   }
+}
+
+static void ReadRegister()
+{
+  static u8 reply[64];
+  u32 id;
+
+  memset(reply, 0, sizeof reply);
+  id = Hex2char(s_cmd_bfr[1]);
+  if (s_cmd_bfr[2] != '\0')
+  {
+    id <<= 4;
+    id |= Hex2char(s_cmd_bfr[2]);
+  }
+
+  if (WriteRegisterHex(reply, id) == 0)
+    return SendReply("E01");
 
   SendReply((char*)reply);
 }
 
+// The registers in the 'g' packet are the ones GDB numbers first: the GPRs, the FPRs, then PC,
+// MSR, CR, LR, CTR, XER and FPSCR. GDB fetches the rest with 'p' when it needs them.
+constexpr u32 NUM_G_PACKET_REGISTERS = 71;
+
 static void ReadRegisters()
 {
-  auto& system = Core::System::GetInstance();
-  auto& ppc_state = system.GetPPCState();
-
   static u8 bfr[GDB_BFR_MAX - 4];
   u8* bufptr = bfr;
   u32 i;
 
   memset(bfr, 0, sizeof bfr);
 
-  for (i = 0; i < 32; i++)
+  for (i = 0; i < NUM_G_PACKET_REGISTERS; i++)
   {
-    wbe32hex(bufptr + i * 8, ppc_state.gpr[i]);
+    bufptr += WriteRegisterHex(bufptr, i);
   }
-  bufptr += 32 * 8;
 
   SendReply((char*)bfr);
 }
 
-static void WriteRegisters()
-{
-  auto& system = Core::System::GetInstance();
-  auto& ppc_state = system.GetPPCState();
-
-  u32 i;
-  u8* bufptr = s_cmd_bfr;
-
-  for (i = 0; i < 32; i++)
-  {
-    ppc_state.gpr[i] = re32hex(bufptr + i * 8);
-  }
-  bufptr += 32 * 8;
-
-  SendReply("OK");
-}
-
-static void WriteRegister()
+// Sets the register from its hex representation in bufptr. Returns false if the register doesn't
+// exist.
+static bool ReadRegisterHex(u8* bufptr, u32 id)
 {
   auto& system = Core::System::GetInstance();
   auto& ppc_state = system.GetPPCState();
 
-  u32 id;
-
-  u8* bufptr = s_cmd_bfr + 3;
-
-  id = Hex2char(s_cmd_bfr[1]);
-  if (s_cmd_bfr[2] != '=')
-  {
-    ++bufptr;
-    id <<= 4;
-    id |= Hex2char(s_cmd_bfr[2]);
-  }
-
   if (id < 32)
   {
     ppc_state.gpr[id] = re32hex(bufptr);
@@ -798,11 +880,51 @@ static void WriteRegister()
       ppc_state.spr[SPR_THRM3] = re32hex(bufptr);
       break;
     default:
-      return SendReply("E01");
-      break;
+      return false;
     }
   }
 
+  return true;
+}
+
+static u32 GetRegisterHexSize(u32 id)
+{
+  return (id >= 32 && id < 64) || id == 105 ? 16 : 8;
+}
+
+static void WriteRegister()
+{
+  u32 id;
+
+  u8* bufptr = s_cmd_bfr + 3;
+
+  id = Hex2char(s_cmd_bfr[1]);
+  if (s_cmd_bfr[2] != '=')
+  {
+    ++bufptr;
+    id <<= 4;
+    id |= Hex2char(s_cmd_bfr[2]);
+  }
+
+  if (!ReadRegisterHex(bufptr, id))
+    return SendReply("E01");
+
+  SendReply("OK");
+}
+
+static void WriteRegisters()
+{
+  u32 i;
+  u8* bufptr = s_cmd_bfr + 1;
+  const u8* const end = s_cmd_bfr + s_cmd_len;
+
+  // Only the registers that are included in the packet are set
+  for (i = 0; i < NUM_G_PACKET_REGISTERS && bufptr + GetRegisterHexSize(i) <= end; i++)
+  {
+    ReadRegisterHex(bufptr, i);
+    bufptr += GetRegisterHexSize(i);
+  }
+
   SendReply("OK");
 }
 
@@ -823,8 +945,9 @@ static void ReadMemory(const Core::CPUThreadGuard& guard)
     len = (len << 4) | Hex2char(s_cmd_bfr[i++]);
   INFO_LOG_FMT(GDB_STUB, "gdb: read memory: {:08x} bytes from {:08x}", len, addr);
 
-  if (len * 2 > sizeof reply)
-    SendReply("E01");
+  // Leave room for the null terminator, and avoid len * 2 overflowing
+  if (u64{len} > (sizeof reply - 1) / 2)
+    return SendReply("E01");
 
   if (!PowerPC::MMU::HostIsRAMAddress(guard, addr))
     return SendReply("E00");
@@ -863,6 +986,68 @@ static void WriteMemory(const Core::CPUThreadGuard& guard)
   SendReply("OK");
 }
 
+// Like ReadMemory, but the data is sent as binary instead of hex
+static void ReadMemoryBinary(const Core::CPUThreadGuard& guard)
+{
+  u32 i = 1;
+  const u32 addr = ReadHexNumber(&i);
+  if (i >= s_cmd_len || s_cmd_bfr[i] != ',')
+    return SendReply("E01");
+  i++;
+  const u32 len = ReadHexNumber(&i);
+  INFO_LOG_FMT(GDB_STUB, "gdb: read binary memory: {:08x} bytes from {:08x}", len, addr);
+
+  // Clients probe for support of the packet by reading nothing
+  std::string reply = s_binary_upload ? "b" : "";
+  if (len == 0)
+    return SendReply(s_binary_upload ? reply : "OK");
+
+  if (!PowerPC::MMU::HostIsRAMAddress(guard, addr))
+    return SendReply("E00");
+
+  // Clients continue reading from where the reply ends if not all of the data fits into it
+  const u32 max_len = std::min<u32>(len, GDB_BFR_MAX - 4);
+  if (!PowerPC::MMU::HostIsRAMAddress(guard, addr + max_len - 1))
+    return SendReply("E00");
+
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+  const u8* data = memory.GetPointer(addr);
+  AppendEscapedBinary(&reply, data, max_len, GDB_BFR_MAX - 4);
+  SendReply(reply);
+}
+
+static void WriteMemoryBinary(const Core::CPUThreadGuard& guard)
+{
+  u32 i = 1;
+  const u32 addr = ReadHexNumber(&i);
+  if (i >= s_cmd_len || s_cmd_bfr[i] != ',')
+    return SendReply("E01");
+  i++;
+  const u32 len = ReadHexNumber(&i);
+  if (i >= s_cmd_len || s_cmd_bfr[i] != ':')
+    return SendReply("E01");
+  i++;
+  INFO_LOG_FMT(GDB_STUB, "gdb: write binary memory: {:08x} bytes to {:08x}", len, addr);
+
+  // Clients probe for support of the packet by writing nothing
+  if (len == 0)
+    return SendReply("OK");
+
+  if (!PowerPC::MMU::HostIsRAMAddress(guard, addr) ||
+      !PowerPC::MMU::HostIsRAMAddress(guard, addr + len - 1))
+  {
+    return SendReply("E00");
+  }
+
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+  u8* dst = memory.GetPointer(addr);
+  if (UnescapeBinary(dst, s_cmd_bfr + i, s_cmd_bfr + s_cmd_len, len) != len)
+    return SendReply("E01");
+  SendReply("OK");
+}
+
 static void Step()
 {
   auto& system = Core::System::GetInstance();
@@ -1009,12 +1194,24 @@ void ProcessCommands(bool loop_until_continue)
       ReadMemory(guard);
       break;
     }
+    case 'x':
+    {
+      ASSERT(Core::IsCPUThread());
+      Core::CPUThreadGuard guard(system);
+
+      ReadMemoryBinary(guard);
+      break;
+    }
     case 'M':
+    case 'X':
     {
       ASSERT(Core::IsCPUThread());
       Core::CPUThreadGuard guard(system);
 
-      WriteMemory(guard);
+      if (s_cmd_bfr[0] == 'M')
+        WriteMemory(guard);
+      else
+        WriteMemoryBinary(guard);
       auto& ppc_state = system.GetPPCState();
       ppc_state.iCache.Reset();
       Host_UpdateDisasmDialog();
@@ -1102,6 +1299,7 @@ static void InitGeneric(int domain, const sockaddr* server_addr, socklen_t serve
     ERROR_LOG_FMT(GDB_STUB, "Failed to accept gdb client");
   INFO_LOG_FMT(GDB_STUB, "Client connected.");
   s_just_connected = true;
+  s_binary_upload = false;
 
 #ifdef _WIN32
   closesocket(s_tmpsock);
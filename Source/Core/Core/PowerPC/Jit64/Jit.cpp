@@ -807,6 +807,8 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     return;
   }
 
+  DetectModifiedCode();
+
   if (SetEmitterStateToFreeCodeRegion())
   {
     u8* near_start = GetWritableCodePtr();
@@ -908,6 +910,33 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+
+  const std::vector<u32> icache_blocks = SetUpICacheCheck(*b);
+  if (!icache_blocks.empty())
+  {
+    SwitchToFarCode();
+    const u8* icache_miss = GetCodePtr();
+    MOV(64, R(ABI_PARAM2), ImmPtr(b));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionP(JitBase::CheckICacheFromJIT, static_cast<JitBase*>(this));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    TEST(8, R(ABI_RETURN), R(ABI_RETURN));
+    FixupBranch still_cached = J_CC(CC_NZ, Jump::Near);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    JMP(asm_routines.dispatcher_no_check, Jump::Near);
+    SwitchToNearCode();
+
+    // This only catches cache blocks which are still evicted when the block is entered. If one gets
+    // fetched again in the meantime, such as while compiling another block, it goes unnoticed.
+    for (u32 cache_block : icache_blocks)
+    {
+      MOV(64, R(RSCRATCH), ImmPtr(m_ppc_state.iCache.GetLookupTableEntry(cache_block)));
+      CMP(8, MatR(RSCRATCH), Imm8(0xFF));
+      J_CC(CC_E, icache_miss);
+    }
+    SetJumpTarget(still_cached);
+  }
+
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
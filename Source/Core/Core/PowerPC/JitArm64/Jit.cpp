@@ -963,6 +963,8 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     return;
   }
 
+  DetectModifiedCode();
+
   if (SetEmitterStateToFreeCodeRegion())
   {
     u8* near_start = GetWritableCodePtr();
@@ -1058,6 +1060,36 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     BeginTimeProfile(b);
   }
 
+  const std::vector<u32> icache_blocks = SetUpICacheCheck(*b);
+  if (!icache_blocks.empty())
+  {
+    // This only catches cache blocks which are still evicted when the block is entered. If one gets
+    // fetched again in the meantime, such as while compiling another block, it goes unnoticed.
+    std::vector<FixupBranch> icache_misses;
+    for (u32 cache_block : icache_blocks)
+    {
+      MOVP2R(ARM64Reg::X0, m_ppc_state.iCache.GetLookupTableEntry(cache_block));
+      LDRB(IndexType::Unsigned, ARM64Reg::W0, ARM64Reg::X0, 0);
+      CMP(ARM64Reg::W0, 0xFF);
+      FixupBranch cached = B(CC_NEQ);
+      icache_misses.push_back(B());
+      SetJumpTarget(cached);
+    }
+
+    SwitchToFarCode();
+    for (FixupBranch& icache_miss : icache_misses)
+      SetJumpTarget(icache_miss);
+    ABI_CallFunction(&JitBase::CheckICacheFromJIT, static_cast<JitBase*>(this), b);
+    FixupBranch modified = CBZ(ARM64Reg::W0);
+    FixupBranch still_cached = B();
+    SetJumpTarget(modified);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    B(dispatcher_no_check);
+    SwitchToNearCode();
+    SetJumpTarget(still_cached);
+  }
+
   if (code_block.m_gqr_used.Count() == 1 &&
       js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
   {
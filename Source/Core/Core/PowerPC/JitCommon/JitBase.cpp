@@ -57,7 +57,7 @@
 // After resetting the stack to the top, we call _resetstkoflw() to restore
 // the guard page at the 256kb mark.
 
-const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JitBase::JIT_SETTINGS{{
+const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JitBase::JIT_SETTINGS{{
     {&JitBase::bJITOff, &Config::MAIN_DEBUG_JIT_OFF},
     {&JitBase::bJITLoadStoreOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_OFF},
     {&JitBase::bJITLoadStorelXzOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_LXZ_OFF},
@@ -80,6 +80,7 @@ const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JitB
     {&JitBase::m_accurate_nans, &Config::MAIN_ACCURATE_NANS},
     {&JitBase::m_fastmem_enabled, &Config::MAIN_FASTMEM},
     {&JitBase::m_accurate_cpu_cache_enabled, &Config::MAIN_ACCURATE_CPU_CACHE},
+    {&JitBase::m_icache_check_enabled, &Config::MAIN_JIT_ICACHE_CHECK},
 }};
 
 const u8* JitBase::Dispatch(JitBase& jit)
@@ -87,6 +88,27 @@ const u8* JitBase::Dispatch(JitBase& jit)
   return jit.GetBlockCache()->Dispatch();
 }
 
+bool JitBase::CheckICacheFromJIT(JitBase& jit, JitBlock* block)
+{
+  // Fetch the instructions again like the CPU would after a cache miss. If memory has been modified
+  // since the block was compiled, the CPU now sees the new instructions.
+  std::vector<u32> modified_addresses;
+  for (const JitBlock::CachedInstruction& instruction : block->cached_instructions)
+  {
+    if (jit.m_ppc_state.iCache.ReadInstruction(instruction.physical_address) != instruction.hex)
+      modified_addresses.push_back(instruction.address);
+  }
+
+  if (modified_addresses.empty())
+    return true;
+
+  // This destroys the block, so it can't be accessed anymore
+  for (u32 address : modified_addresses)
+    jit.GetBlockCache()->InvalidateICacheLine(address);
+
+  return false;
+}
+
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
   jit.Jit(em_address);
@@ -276,6 +298,68 @@ bool JitBase::CanMergeNextInstructions(int count) const
   return true;
 }
 
+void JitBase::DetectModifiedCode()
+{
+  if (!m_icache_check_enabled)
+    return;
+
+  JitBaseBlockCache* block_cache = GetBlockCache();
+
+  std::vector<u32> modified_addresses;
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+  {
+    const PPCAnalyst::CodeOp& op = m_code_buffer[i];
+    if (block_cache->HasCompiledInstructionChanged(op.physical_address, op.inst.hex))
+    {
+      block_cache->MarkSelfModifyingCode(op.physical_address);
+      modified_addresses.push_back(op.address);
+    }
+  }
+
+  // Invalidating also forgets the instructions compiled from these addresses, so record the new
+  // ones afterwards
+  for (u32 address : modified_addresses)
+    block_cache->InvalidateICacheLine(address);
+
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+  {
+    const PPCAnalyst::CodeOp& op = m_code_buffer[i];
+    block_cache->RecordCompiledInstruction(op.physical_address, op.inst.hex);
+  }
+}
+
+std::vector<u32> JitBase::SetUpICacheCheck(JitBlock& block)
+{
+  block.cached_instructions.clear();
+
+  // Without the instruction cache, modified code is seen right away and there's nothing to check
+  if (!m_icache_check_enabled || !HID0(m_ppc_state).ICE || m_ppc_state.iCache.m_disable_icache)
+    return {};
+
+  if (!GetBlockCache()->IsSelfModifyingCode(code_block.m_physical_addresses))
+    return {};
+
+  std::vector<u32> cache_blocks;
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+  {
+    const PPCAnalyst::CodeOp& op = m_code_buffer[i];
+
+    // Instructions in the fake VMEM are never fetched through the instruction cache
+    if (op.physical_address & PowerPC::CACHE_VMEM_BIT)
+    {
+      block.cached_instructions.clear();
+      return {};
+    }
+
+    block.cached_instructions.push_back({op.address, op.physical_address, op.inst.hex});
+    cache_blocks.push_back(op.physical_address & ~0x1f);
+  }
+
+  std::sort(cache_blocks.begin(), cache_blocks.end());
+  cache_blocks.erase(std::unique(cache_blocks.begin(), cache_blocks.end()), cache_blocks.end());
+  return cache_blocks;
+}
+
 bool JitBase::ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op)
 {
   if (jo.fp_exceptions)
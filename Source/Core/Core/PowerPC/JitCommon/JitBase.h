@@ -8,6 +8,7 @@
 #include <map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
@@ -156,12 +157,13 @@ protected:
   bool m_accurate_nans = false;
   bool m_fastmem_enabled = false;
   bool m_accurate_cpu_cache_enabled = false;
+  bool m_icache_check_enabled = false;
 
   bool m_enable_blr_optimization = false;
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
 
-  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JIT_SETTINGS;
+  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JIT_SETTINGS;
 
   bool DoesConfigNeedRefresh();
   void RefreshConfig();
@@ -177,6 +179,19 @@ protected:
 
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
 
+  // Compares the instructions of the block being compiled with the ones previously compiled from
+  // the same addresses. If they differ, the game has modified the code without invalidating it, so
+  // its pages are marked as self-modifying and the blocks compiled from the old code are
+  // invalidated. Must be called before the block is allocated.
+  void DetectModifiedCode();
+
+  // Games which modify code without invalidating the instruction cache only see the new code once
+  // the old code has been evicted from the cache. If the block being compiled is in a region where
+  // code gets modified, this prepares the block to check on entry that the cache blocks it was
+  // compiled from are still cached, and returns the addresses of those cache blocks. Otherwise,
+  // returns an empty vector.
+  std::vector<u32> SetUpICacheCheck(JitBlock& block);
+
 public:
   explicit JitBase(Core::System& system);
   JitBase(const JitBase&) = delete;
@@ -188,6 +203,9 @@ public:
   bool IsDebuggingEnabled() const { return m_enable_debugging; }
 
   static const u8* Dispatch(JitBase& jit);
+  // Called by blocks set up by SetUpICacheCheck when one of their cache blocks isn't cached.
+  // Returns false if the block has been invalidated because its code was modified.
+  static bool CheckICacheFromJIT(JitBase& jit, JitBlock* block);
   virtual JitBaseBlockCache* GetBlockCache() = 0;
 
   virtual void Jit(u32 em_address) = 0;
@@ -75,6 +75,7 @@ void JitBaseBlockCache::Clear()
   block_map.clear();
   links_to.clear();
   block_range_map.clear();
+  m_compiled_instructions.clear();
 
   valid_block.ClearAll();
 
@@ -265,6 +266,13 @@ void JitBaseBlockCache::InvalidateICache(u32 initial_address, u32 initial_length
 void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 address, u32 length,
                                                  bool forced)
 {
+  // Code at these addresses may legitimately change from now on
+  if (!m_compiled_instructions.empty())
+  {
+    m_compiled_instructions.erase(m_compiled_instructions.lower_bound(physical_address),
+                                  m_compiled_instructions.lower_bound(physical_address + length));
+  }
+
   // Optimization for the case of invalidating a single cache line, which is used by the dcb*
   // instructions. If the valid_block bit for that cacheline is not set, we can safely skip
   // the remaining invalidation logic.
@@ -290,7 +298,7 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
   if (destroy_block)
   {
     // destroy JIT blocks
-    ErasePhysicalRange(physical_address, length);
+    const bool erased = ErasePhysicalRange(physical_address, length);
 
     // If the code was actually modified, we need to clear the relevant entries from the
     // FIFO write address cache, so we don't end up with FIFO checks in places they shouldn't
@@ -304,12 +312,44 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
         m_jit.js.pairedQuantizeAddresses.erase(i);
         m_jit.js.noSpeculativeConstantsAddresses.erase(i);
       }
+
+      if (erased)
+      {
+        const u32 last_page = (physical_address + (length - 1)) >> 12;
+        for (u32 page = physical_address >> 12; page <= last_page; ++page)
+          m_self_modifying_pages.insert(page);
+      }
     }
   }
 }
 
-void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
+bool JitBaseBlockCache::IsSelfModifyingCode(const std::set<u32>& physical_addresses) const
+{
+  return std::any_of(physical_addresses.begin(), physical_addresses.end(), [this](u32 address) {
+    return m_self_modifying_pages.contains(address >> 12);
+  });
+}
+
+void JitBaseBlockCache::MarkSelfModifyingCode(u32 physical_address)
+{
+  m_self_modifying_pages.insert(physical_address >> 12);
+}
+
+bool JitBaseBlockCache::HasCompiledInstructionChanged(u32 physical_address, u32 hex) const
+{
+  const auto it = m_compiled_instructions.find(physical_address);
+  return it != m_compiled_instructions.end() && it->second != hex;
+}
+
+void JitBaseBlockCache::RecordCompiledInstruction(u32 physical_address, u32 hex)
 {
+  m_compiled_instructions.insert_or_assign(physical_address, hex);
+}
+
+bool JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
+{
+  bool erased = false;
+
   // Iterate over all macro blocks which overlap the given range.
   u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
   auto start = block_range_map.lower_bound(address & range_mask);
@@ -330,6 +370,7 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
             block_range_map[addr & range_mask].erase(block);
 
         // And remove the block.
+        erased = true;
         DestroyBlock(*block);
         auto block_map_iter = block_map.equal_range(block->physicalAddress);
         while (block_map_iter.first != block_map_iter.second)
@@ -355,6 +396,8 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
     else
       start++;
   }
+
+  return erased;
 }
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
@@ -83,6 +83,16 @@ struct JitBlock : public JitBlockData
   // This set stores all physical addresses of all occupied instructions.
   std::set<u32> physical_addresses;
 
+  // The instructions this block was compiled from, if the block checks on entry that they are still
+  // in the instruction cache. See JitBase::CheckICacheFromJIT.
+  struct CachedInstruction
+  {
+    u32 address;
+    u32 physical_address;
+    u32 hex;
+  };
+  std::vector<CachedInstruction> cached_instructions;
+
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
   {
@@ -164,7 +174,18 @@ public:
 
   void InvalidateICache(u32 address, u32 length, bool forced);
   void InvalidateICacheLine(u32 address);
-  void ErasePhysicalRange(u32 address, u32 length);
+  // Returns whether any blocks were erased.
+  bool ErasePhysicalRange(u32 address, u32 length);
+
+  // Returns true if code in any of the pages containing the given addresses has been modified
+  // after being compiled.
+  bool IsSelfModifyingCode(const std::set<u32>& physical_addresses) const;
+  void MarkSelfModifyingCode(u32 physical_address);
+
+  // Returns true if an instruction other than the given one was compiled from the address
+  // before, and the address hasn't been invalidated since.
+  bool HasCompiledInstructionChanged(u32 physical_address, u32 hex) const;
+  void RecordCompiledInstruction(u32 physical_address, u32 hex);
 
   u32* GetBlockBitSet() const;
 
@@ -205,6 +226,16 @@ private:
   // It is used to provide a fast way to query if no icache invalidation is needed.
   ValidBlockBitSet valid_block;
 
+  // Physical pages (in units of 4 KiB) containing code which has been modified after it was
+  // compiled. This survives clearing the cache, since it's used to decide which blocks need extra
+  // checks for code being modified without the game invalidating it.
+  std::unordered_set<u32> m_self_modifying_pages;
+
+  // Physical address -> the instruction last compiled from it, for noticing code that is modified
+  // without being invalidated when it gets compiled again. Only filled when the instruction cache
+  // check is enabled, and emptied along with the blocks when the cache is cleared.
+  std::map<u32, u32> m_compiled_instructions;
+
   // This contains the entry points for each block.
   // It is used by the assembly dispatcher to quickly
   // know where to jump based on pc and msr bits.
@@ -30,6 +30,7 @@
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/Profiler.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/System.h"
 
 #ifdef _M_X86_64
@@ -40,7 +41,8 @@
 #include "Core/PowerPC/JitArm64/Jit.h"
 #endif
 
-JitInterface::JitInterface(Core::System& system) : m_system(system)
+JitInterface::JitInterface(Core::System& system)
+    : m_sampling_profiler(std::make_unique<Profiler::SamplingProfiler>(system)), m_system(system)
 {
 }
 
@@ -341,6 +343,10 @@ void JitInterface::CompileExceptionCheckFromJIT(JitInterface& jit_interface, Exc
 
 void JitInterface::Shutdown()
 {
+  // The profiler reads guest memory, which is about to go away. The samples are kept so that they
+  // can still be written out after emulation has stopped.
+  m_sampling_profiler->Stop();
+
   if (m_jit)
   {
     m_jit->Shutdown();
@@ -26,6 +26,7 @@ enum class CPUCore;
 namespace Profiler
 {
 struct ProfileStats;
+class SamplingProfiler;
 }
 
 class JitInterface
@@ -65,6 +66,7 @@ public:
   void SetProfilingState(ProfilingState state);
   void WriteProfileResults(const std::string& filename) const;
   void GetProfileResults(Profiler::ProfileStats* prof_stats) const;
+  Profiler::SamplingProfiler& GetSamplingProfiler() { return *m_sampling_profiler; }
   std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address) const;
 
   // Memory Utilities
@@ -102,5 +104,6 @@ public:
 
 private:
   std::unique_ptr<JitBase> m_jit;
+  std::unique_ptr<Profiler::SamplingProfiler> m_sampling_profiler;
   Core::System& m_system;
 };
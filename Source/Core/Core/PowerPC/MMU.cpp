@@ -921,9 +921,6 @@ std::optional<ReadResult<std::string>> MMU::HostTryReadString(const Core::CPUThr
 
 bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
-    return false;
-
   if (!m_ppc_state.msr.DR)
     return false;
 
@@ -931,7 +928,8 @@ bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size) cons
     return false;
 
   // We store whether an access can be optimized to an unchecked access
-  // in dbat_table.
+  // in dbat_table. This also takes care of memchecks, since pages that overlap
+  // a memcheck aren't marked as physical.
   const u32 last_byte_address = address + (access_size >> 3) - 1;
   const u32 bat_result_1 = m_dbat_table[address >> BAT_INDEX_SHIFT];
   const u32 bat_result_2 = m_dbat_table[last_byte_address >> BAT_INDEX_SHIFT];
@@ -1222,7 +1220,7 @@ void MMU::TouchDCacheLine(u32 address, bool store)
 
 u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(address, access_size >> 3))
     return 0;
 
   if (!m_ppc_state.msr.DR)
@@ -1248,7 +1246,7 @@ u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
 
 bool MMU::IsOptimizableGatherPipeWrite(u32 address) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(address, sizeof(u64)))
     return false;
 
   if (!m_ppc_state.msr.DR)
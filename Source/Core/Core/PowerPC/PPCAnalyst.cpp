@@ -4,9 +4,14 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <future>
 #include <map>
+#include <optional>
 #include <queue>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <fmt/format.h>
@@ -15,10 +20,12 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HLE/HLE.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -279,37 +286,113 @@ bool PPCAnalyzer::CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b) const
 // called by another function. Therefore, let's scan the
 // entire space for bl operations and find what functions
 // get called.
+static std::optional<u32> GetCallTarget(UGeckoInstruction instr, u32 addr)
+{
+  if (instr.OPCD != 18 || !instr.LK)  // bl
+    return std::nullopt;
+
+  u32 target = SignExt26(instr.LI << 2);
+  if (!instr.AA)
+    target += addr;
+  return target;
+}
+
+// Returns the host memory backing the given instruction address, or nullptr if the address
+// doesn't translate to MEM1 or MEM2. Pages of that memory are contiguous on the host.
+static const u8* GetInstructionRAMPointer(const Core::CPUThreadGuard& guard, u32 addr)
+{
+  auto& system = guard.GetSystem();
+  const PowerPC::TranslateResult translated = system.GetMMU().JitCache_TranslateAddress(addr);
+  if (!translated.valid)
+    return nullptr;
+
+  auto& memory = system.GetMemory();
+  const u32 physical_address = translated.address & 0x3FFFFFFF;
+  if (physical_address < memory.GetRamSizeReal())
+    return memory.GetRAM() + physical_address;
+  if (memory.GetEXRAM() && (physical_address >> 28) == 1 &&
+      (physical_address & 0x0FFFFFFF) < memory.GetExRamSizeReal())
+  {
+    return memory.GetEXRAM() + (physical_address & memory.GetExRamMask());
+  }
+  return nullptr;
+}
+
 static void FindFunctionsFromBranches(const Core::CPUThreadGuard& guard, u32 startAddr, u32 endAddr,
                                       Common::SymbolDB* func_db)
 {
+  struct RAMSpan
+  {
+    u32 address;
+    u32 size;
+    const u8* data;
+  };
+
+  // Only address translation needs the MMU, and it's the same for a whole page. Once the RAM
+  // backing each page is known, it can be scanned on several threads without touching the
+  // emulated state. Pages that aren't backed by RAM are rare enough to just be read here.
+  std::vector<RAMSpan> spans;
+  std::vector<u32> targets;
   auto& mmu = guard.GetSystem().GetMMU();
-  for (u32 addr = startAddr; addr < endAddr; addr += 4)
+  for (u64 page = startAddr & ~PowerPC::HW_PAGE_MASK; page < endAddr; page += PowerPC::HW_PAGE_SIZE)
   {
-    const PowerPC::TryReadInstResult read_result = mmu.TryReadInstruction(addr);
-    const UGeckoInstruction instr = read_result.hex;
+    const u32 begin = static_cast<u32>(std::max<u64>(page, startAddr));
+    const u32 end = static_cast<u32>(std::min<u64>(page + PowerPC::HW_PAGE_SIZE, endAddr));
+    if (const u8* data = GetInstructionRAMPointer(guard, begin))
+    {
+      spans.push_back({begin, end - begin, data});
+      continue;
+    }
 
-    if (read_result.valid && PPCTables::IsValidInstruction(instr, addr))
+    for (u32 addr = begin; addr < end; addr += 4)
     {
-      switch (instr.OPCD)
-      {
-      case 18:  // branch instruction
+      const PowerPC::TryReadInstResult read_result = mmu.TryReadInstruction(addr);
+      if (!read_result.valid)
+        continue;
+      if (const std::optional<u32> target = GetCallTarget(read_result.hex, addr))
+        targets.push_back(*target);
+    }
+  }
+
+  std::vector<std::vector<u32>> span_targets(spans.size());
+  std::atomic<size_t> next_span = 0;
+  const auto scan_spans = [&] {
+    for (size_t i = next_span++; i < spans.size(); i = next_span++)
+    {
+      const RAMSpan& span = spans[i];
+      for (u32 offset = 0; offset + sizeof(u32) <= span.size; offset += sizeof(u32))
       {
-        if (instr.LK)  // bl
-        {
-          u32 target = SignExt26(instr.LI << 2);
-          if (!instr.AA)
-            target += addr;
-          if (PowerPC::MMU::HostIsRAMAddress(guard, target))
-          {
-            func_db->AddFunction(guard, target);
-          }
-        }
-      }
-      break;
-      default:
-        break;
+        u32 hex;
+        std::memcpy(&hex, span.data + offset, sizeof(hex));
+        const u32 addr = span.address + offset;
+        if (const std::optional<u32> target = GetCallTarget(Common::swap32(hex), addr))
+          span_targets[i].push_back(*target);
       }
     }
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(spans.size(), std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < thread_count; ++i)
+    futures.push_back(std::async(std::launch::async, scan_spans));
+
+  scan_spans();
+
+  for (std::future<void>& future : futures)
+    future.wait();
+
+  for (const std::vector<u32>& span_target : span_targets)
+    targets.insert(targets.end(), span_target.begin(), span_target.end());
+
+  // Most functions are called from many places, so only analyze each of them once
+  std::sort(targets.begin(), targets.end());
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+  for (const u32 target : targets)
+  {
+    if (PowerPC::MMU::HostIsRAMAddress(guard, target))
+      func_db->AddFunction(guard, target);
   }
 }
 
@@ -842,6 +925,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     code[i] = {};
     code[i].opinfo = opinfo;
     code[i].address = address;
+    code[i].physical_address = result.physical_address;
     code[i].inst = inst;
     code[i].skip = false;
     block->m_stats->numCycles += opinfo->num_cycles;
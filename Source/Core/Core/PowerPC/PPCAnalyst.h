@@ -31,6 +31,7 @@ struct CodeOp  // 16B
   UGeckoInstruction inst;
   const GekkoOPInfo* opinfo = nullptr;
   u32 address = 0;
+  u32 physical_address = 0;
   u32 branchTo = 0;  // if UINT32_MAX, not a branch
   BitSet32 regsIn;
   BitSet32 regsOut;
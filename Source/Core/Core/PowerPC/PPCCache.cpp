@@ -100,9 +100,15 @@ void Cache::Reset()
   valid.fill(0);
   plru.fill(0);
   modified.fill(0);
-  std::fill(lookup_table.begin(), lookup_table.end(), 0xFF);
-  std::fill(lookup_table_ex.begin(), lookup_table_ex.end(), 0xFF);
-  std::fill(lookup_table_vmem.begin(), lookup_table_vmem.end(), 0xFF);
+
+  // Only the parts of the lookup tables that the current memory sizes can index are used
+  auto& memory = Core::System::GetInstance().GetMemory();
+  const auto reset_table = [](std::vector<u8>* table, u32 memory_size) {
+    std::fill_n(table->begin(), std::min<size_t>(table->size(), memory_size >> 5), 0xFF);
+  };
+  reset_table(&lookup_table, memory.GetRamSize());
+  reset_table(&lookup_table_ex, memory.GetExRamSize());
+  reset_table(&lookup_table_vmem, memory.GetFakeVMemSize());
 }
 
 void InstructionCache::Reset()
@@ -118,9 +124,19 @@ void Cache::Init()
 
   data.fill({});
   addrs.fill({});
-  lookup_table.resize(memory.GetRamSize() >> 5);
-  lookup_table_ex.resize(memory.GetExRamSize() >> 5);
-  lookup_table_vmem.resize(memory.GetFakeVMemSize() >> 5);
+
+  // The JITs embed the addresses of lookup table entries in their code (see GetLookupTableEntry),
+  // so the tables must never be reallocated while compiled code exists. They're allocated once for
+  // the largest memory sizes that can be configured in the GUI. A larger size set by hand in the
+  // INI reallocates them here, which is safe because Init only runs at boot, before any code is
+  // compiled.
+  const auto allocate_table = [](std::vector<u8>* table, u32 memory_size) {
+    if (table->size() < (memory_size >> 5))
+      table->resize(memory_size >> 5);
+  };
+  allocate_table(&lookup_table, std::max(memory.GetRamSize(), Memory::MEM1_SIZE_GDEV));
+  allocate_table(&lookup_table_ex, std::max(memory.GetExRamSize(), Memory::MEM2_SIZE_NDEV));
+  allocate_table(&lookup_table_vmem, memory.GetFakeVMemSize());
   Reset();
 }
 
@@ -288,6 +304,19 @@ std::pair<u32, u32> Cache::GetCache(u32 addr, bool locked)
   return {set, way};
 }
 
+const u8* Cache::GetLookupTableEntry(u32 addr) const
+{
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+
+  if (addr & CACHE_VMEM_BIT)
+    return &lookup_table_vmem[(addr & memory.GetFakeVMemMask()) >> 5];
+  else if (addr & CACHE_EXRAM_BIT)
+    return &lookup_table_ex[(addr & memory.GetExRamMask()) >> 5];
+  else
+    return &lookup_table[(addr & memory.GetRamMask()) >> 5];
+}
+
 void Cache::Read(u32 addr, void* buffer, u32 len, bool locked)
 {
   auto& system = Core::System::GetInstance();
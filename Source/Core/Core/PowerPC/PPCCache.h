@@ -51,6 +51,11 @@ struct Cache
 
   std::pair<u32, u32> GetCache(u32 addr, bool locked);
 
+  // Returns the lookup table entry for the cache block containing addr. The entry is 0xFF if that
+  // cache block isn't cached. This lets JIT code check whether something is cached on its own.
+  // The address stays valid for the whole emulation session.
+  const u8* GetLookupTableEntry(u32 addr) const;
+
   void Read(u32 addr, void* buffer, u32 len, bool locked);
   void Write(u32 addr, const void* buffer, u32 len, bool locked);
 
@@ -0,0 +1,206 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/SamplingProfiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Common/Thread.h"
+#include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace Profiler
+{
+SamplingProfiler::SamplingProfiler(Core::System& system) : m_system(system)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+  Stop();
+}
+
+void SamplingProfiler::Start(std::chrono::microseconds interval)
+{
+  Stop();
+
+  {
+    std::lock_guard lk(m_samples_lock);
+    m_samples.clear();
+    m_sample_count = 0;
+  }
+
+  m_stop_event.Reset();
+  m_running = true;
+  m_thread = std::thread(&SamplingProfiler::ThreadFunc, this, interval);
+}
+
+void SamplingProfiler::Stop()
+{
+  if (!m_thread.joinable())
+    return;
+
+  m_stop_event.Set();
+  m_thread.join();
+  m_running = false;
+
+  INFO_LOG_FMT(POWERPC, "Sampling profiler stopped after {} samples", GetSampleCount());
+}
+
+bool SamplingProfiler::IsRunning() const
+{
+  return m_running;
+}
+
+u64 SamplingProfiler::GetSampleCount() const
+{
+  std::lock_guard lk(m_samples_lock);
+  return m_sample_count;
+}
+
+void SamplingProfiler::ThreadFunc(std::chrono::microseconds interval)
+{
+  Common::SetCurrentThreadName("PPC Sampling Profiler");
+
+  while (!m_stop_event.WaitFor(interval))
+    TakeSample();
+}
+
+std::optional<u32> SamplingProfiler::ReadGuestU32(u32 address) const
+{
+  // Stacks live in BAT-mapped RAM in practically every game, so rather than going through the MMU
+  // (which isn't safe to do off the CPU thread), only the fixed cached and uncached mappings of
+  // MEM1 and MEM2 are handled.
+  if ((address & 3) != 0 || (address >> 30) != 2)
+    return std::nullopt;
+
+  auto& memory = m_system.GetMemory();
+  const u32 physical_address = address & 0x3FFFFFFF;
+
+  const u8* pointer = nullptr;
+  if (physical_address < memory.GetRamSizeReal())
+  {
+    pointer = memory.GetRAM() + physical_address;
+  }
+  else if (memory.GetEXRAM() && (physical_address >> 28) == 1 &&
+           (physical_address & 0x0FFFFFFF) < memory.GetExRamSizeReal())
+  {
+    pointer = memory.GetEXRAM() + (physical_address & memory.GetExRamMask());
+  }
+
+  if (!pointer)
+    return std::nullopt;
+
+  u32 value;
+  std::memcpy(&value, pointer, sizeof(value));
+  return Common::swap32(value);
+}
+
+void SamplingProfiler::TakeSample()
+{
+  if (m_system.GetCPU().GetState() != CPU::State::Running)
+    return;
+
+  // These are read while the CPU thread keeps running. Torn reads aren't a concern since each of
+  // them is a naturally aligned 32-bit value.
+  const auto& ppc_state = m_system.GetPPCState();
+  const u32 pc = ppc_state.pc;
+  const u32 lr = LR(ppc_state);
+  const u32 sp = ppc_state.gpr[1];
+
+  std::vector<u32> stack;
+  stack.reserve(MAX_STACK_DEPTH + 2);
+  stack.push_back(pc);
+  stack.push_back(lr);
+
+  // Every stack frame starts with a pointer to the previous frame, followed by the slot where the
+  // callee of that frame saved LR. See Dolphin_Debugger::WalkTheStack.
+  std::optional<u32> frame = ReadGuestU32(sp);
+  for (size_t depth = 0; frame && *frame != 0 && depth < MAX_STACK_DEPTH; ++depth)
+  {
+    const std::optional<u32> return_address = ReadGuestU32(*frame + 4);
+    if (!return_address || *return_address == 0)
+      break;
+    stack.push_back(*return_address);
+
+    // Stacks grow downwards, so anything else means that the chain is corrupt
+    const std::optional<u32> next_frame = ReadGuestU32(*frame);
+    if (next_frame && *next_frame != 0 && *next_frame <= *frame)
+      break;
+    frame = next_frame;
+  }
+
+  std::lock_guard lk(m_samples_lock);
+  ++m_samples[std::move(stack)];
+  ++m_sample_count;
+}
+
+static std::string GetFrameName(u32 address)
+{
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  if (!symbol)
+    return fmt::format("{:08x}", address);
+
+  // Semicolons separate the frames of a folded stack
+  std::string name = symbol->name;
+  std::replace(name.begin(), name.end(), ';', ':');
+  return name;
+}
+
+bool SamplingProfiler::WriteFoldedStacks(const std::string& filename) const
+{
+  std::map<std::string, u64> folded_stacks;
+  {
+    std::lock_guard lk(m_samples_lock);
+    for (const auto& [stack, count] : m_samples)
+    {
+      // The return addresses point to the instruction after the call
+      std::vector<std::string> frames;
+      frames.reserve(stack.size());
+      frames.push_back(GetFrameName(stack[0]));
+      for (size_t i = 1; i < stack.size(); ++i)
+        frames.push_back(GetFrameName(stack[i] - 4));
+
+      // LR is only a frame of its own if the sampled function hasn't stored it on the stack (leaf
+      // functions never do). Otherwise it's either stale or duplicates the first stack frame.
+      if (frames.size() > 2 && (frames[1] == frames[2] || frames[1] == frames[0]))
+        frames.erase(frames.begin() + 1);
+      else if (frames.size() == 2 && frames[1] == frames[0])
+        frames.pop_back();
+
+      std::string line;
+      for (auto it = frames.rbegin(); it != frames.rend(); ++it)
+      {
+        if (!line.empty())
+          line += ';';
+        line += *it;
+      }
+      folded_stacks[std::move(line)] += count;
+    }
+  }
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open {} for writing the sampled profile", filename);
+    return false;
+  }
+
+  for (const auto& [stack, count] : folded_stacks)
+    f.WriteString(fmt::format("{} {}\n", stack, count));
+
+  return true;
+}
+
+}  // namespace Profiler
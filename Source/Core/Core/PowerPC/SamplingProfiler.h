@@ -0,0 +1,77 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+
+namespace Core
+{
+class System;
+}
+
+namespace Profiler
+{
+// Statistical profiler for guest code. Unlike block profiling, which makes every JIT block update
+// its own counters, this leaves the generated code untouched: a separate thread periodically
+// looks at the guest PC and walks the guest call stack, so the cost doesn't depend on how much
+// code the game runs and the profiler can be left enabled during normal play.
+//
+// The JITs store the address of a block in PC before entering it, so samples taken while JIT code
+// is running are attributed to the block being executed. Neither the registers nor guest memory
+// are locked while sampling, so an individual sample can contain a bogus frame if it's taken while
+// a function is setting up its stack frame. This averages out over a profiling session.
+class SamplingProfiler final
+{
+public:
+  static constexpr std::chrono::microseconds DEFAULT_INTERVAL{1000};
+
+  explicit SamplingProfiler(Core::System& system);
+  SamplingProfiler(const SamplingProfiler&) = delete;
+  SamplingProfiler(SamplingProfiler&&) = delete;
+  SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+  SamplingProfiler& operator=(SamplingProfiler&&) = delete;
+  ~SamplingProfiler();
+
+  // Starting the profiler discards the samples of the previous session.
+  void Start(std::chrono::microseconds interval = DEFAULT_INTERVAL);
+  void Stop();
+  bool IsRunning() const;
+
+  u64 GetSampleCount() const;
+
+  // Writes the samples as symbolized folded stacks ("outer;inner;leaf count" on each line), the
+  // input format of flamegraph.pl and most other flame graph viewers.
+  bool WriteFoldedStacks(const std::string& filename) const;
+
+private:
+  static constexpr size_t MAX_STACK_DEPTH = 32;
+
+  void ThreadFunc(std::chrono::microseconds interval);
+  void TakeSample();
+  std::optional<u32> ReadGuestU32(u32 address) const;
+
+  Core::System& m_system;
+
+  std::thread m_thread;
+  Common::Event m_stop_event;
+  std::atomic<bool> m_running = false;
+
+  // Raw return addresses, innermost first. Symbolization happens when the profile is written, both
+  // to keep sampling cheap and because symbols are often loaded after profiling has started.
+  mutable std::mutex m_samples_lock;
+  std::map<std::vector<u32>, u64> m_samples;
+  u64 m_sample_count = 0;
+};
+
+}  // namespace Profiler
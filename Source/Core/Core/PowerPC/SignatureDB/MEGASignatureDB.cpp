@@ -7,9 +7,11 @@
 #include <cstdlib>
 #include <fstream>
 #include <limits>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
@@ -101,21 +103,25 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
-bool Compare(const Core::CPUThreadGuard& guard, u32 address, u32 size, const MEGASignature& sig)
+bool Compare(const std::vector<u32>& code, const MEGASignature& sig)
 {
-  if (size != sig.code.size() * sizeof(u32))
+  if (code.size() != sig.code.size())
     return false;
 
   for (size_t i = 0; i < sig.code.size(); ++i)
   {
-    if (sig.code[i] != 0 && PowerPC::MMU::HostRead_U32(
-                                guard, static_cast<u32>(address + i * sizeof(u32))) != sig.code[i])
-    {
+    if (sig.code[i] != 0 && code[i] != sig.code[i])
       return false;
-    }
   }
   return true;
 }
+
+// Signatures are bucketed by their length and their first instruction, with 0 standing for a
+// wildcard first instruction like in MEGASignature::code.
+u64 GetIndexKey(size_t num_instructions, u32 first_instruction)
+{
+  return (static_cast<u64>(num_instructions) << 32) | first_instruction;
+}
 }  // Anonymous namespace
 
 MEGASignatureDB::MEGASignatureDB() = default;
@@ -124,6 +130,7 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_index.clear();
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -140,8 +147,9 @@ bool MEGASignatureDB::Load(const std::string& file_path)
     std::istringstream iss(line);
     MEGASignature sig;
 
-    if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
+    if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss) && !sig.code.empty())
     {
+      m_index[GetIndexKey(sig.code.size(), sig.code[0])].push_back(m_signatures.size());
       m_signatures.push_back(std::move(sig));
     }
     else
@@ -160,19 +168,56 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
 
 void MEGASignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
 {
+  std::vector<u32> code;
   for (auto& it : symbol_db->AccessSymbols())
   {
     auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    if (symbol.size == 0 || symbol.size % sizeof(u32) != 0)
+      continue;
+
+    // Only the signatures with the right length and first instruction can possibly match, which
+    // usually rules out all but a handful of them without reading the rest of the function.
+    const size_t num_instructions = symbol.size / sizeof(u32);
+    const u32 first_instruction = PowerPC::MMU::HostRead_U32(guard, symbol.address);
+    const auto exact = m_index.find(GetIndexKey(num_instructions, first_instruction));
+    const auto wildcard = m_index.find(GetIndexKey(num_instructions, 0));
+    if (exact == m_index.end() && wildcard == m_index.end())
+      continue;
+
+    code.resize(num_instructions);
+    code[0] = first_instruction;
+    for (size_t i = 1; i < num_instructions; ++i)
+    {
+      const u32 address = static_cast<u32>(symbol.address + i * sizeof(u32));
+      code[i] = PowerPC::MMU::HostRead_U32(guard, address);
+    }
+
+    // When several signatures match, the first one in the database wins
+    std::optional<size_t> match;
+    for (const auto& bucket : {exact, wildcard})
     {
-      if (Compare(guard, symbol.address, symbol.size, sig))
+      if (bucket == m_index.end())
+        continue;
+
+      for (const size_t index : bucket->second)
       {
-        symbol.name = sig.name;
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
-                     symbol.size);
-        break;
+        if (match && *match < index)
+          break;
+        if (Compare(code, m_signatures[index]))
+        {
+          match = index;
+          break;
+        }
       }
     }
+
+    if (match)
+    {
+      const MEGASignature& sig = m_signatures[*match];
+      symbol.name = sig.name;
+      INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
+                   symbol.size);
+    }
   }
   symbol_db->Index();
 }
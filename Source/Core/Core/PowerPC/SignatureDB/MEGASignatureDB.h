@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -59,4 +60,7 @@ public:
 
 private:
   std::vector<MEGASignature> m_signatures;
+
+  // Indices into m_signatures, keyed by the length and the first instruction of the signature
+  std::unordered_map<u64, std::vector<size_t>> m_index;
 };
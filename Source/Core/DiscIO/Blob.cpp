@@ -7,11 +7,14 @@
 #include <cstddef>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "DiscIO/CISOBlob.h"
@@ -61,6 +64,58 @@ std::string GetName(BlobType blob_type, bool translate)
   }
 }
 
+bool BlobReader::ReadConcurrent(u64 offset, u64 size, u8* out_ptr)
+{
+  std::unique_ptr<BlobReader> reader = AcquireConcurrentReader();
+  if (!reader)
+    return false;
+
+  const bool success = reader->Read(offset, size, out_ptr);
+  ReleaseConcurrentReader(std::move(reader));
+  return success;
+}
+
+bool BlobReader::ReadWiiDecryptedConcurrent(u64 offset, u64 size, u8* out_ptr,
+                                            u64 partition_data_offset)
+{
+  std::unique_ptr<BlobReader> reader = AcquireConcurrentReader();
+  if (!reader)
+    return false;
+
+  const bool success = reader->ReadWiiDecrypted(offset, size, out_ptr, partition_data_offset);
+  ReleaseConcurrentReader(std::move(reader));
+  return success;
+}
+
+std::unique_ptr<BlobReader> BlobReader::AcquireConcurrentReader()
+{
+  {
+    std::lock_guard lk(m_concurrent_readers_mutex);
+    if (!m_concurrent_readers.empty())
+    {
+      std::unique_ptr<BlobReader> reader = std::move(m_concurrent_readers.back());
+      m_concurrent_readers.pop_back();
+      return reader;
+    }
+  }
+
+  // CopyReader only reads state that never changes after creation, so it's safe to call here.
+  std::unique_ptr<BlobReader> reader = CopyReader();
+  if (!reader)
+    ERROR_LOG_FMT(DISCIO, "Failed to create a reader for concurrent reads");
+  return reader;
+}
+
+void BlobReader::ReleaseConcurrentReader(std::unique_ptr<BlobReader> reader)
+{
+  // Don't keep more readers around than there are threads that could be using them at once.
+  const size_t max_readers = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+  std::lock_guard lk(m_concurrent_readers_mutex);
+  if (m_concurrent_readers.size() < max_readers)
+    m_concurrent_readers.push_back(std::move(reader));
+}
+
 void SectorReader::SetSectorSize(int blocksize)
 {
   m_block_size = std::max(blocksize, 0);
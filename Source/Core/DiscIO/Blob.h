@@ -16,6 +16,7 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -25,6 +26,7 @@
 
 namespace DiscIO
 {
+class ChunkStore;
 enum class WIARVZCompressionType : u32;
 
 // Increment CACHE_REVISION (GameFileCache.cpp) if the enum below is modified
@@ -97,8 +99,23 @@ public:
     return false;
   }
 
+  // Thread-safe versions of Read and ReadWiiDecrypted. They can be called from any number of
+  // threads at once, and don't disturb the state used by Read (such as decompression caches).
+  // The default implementation keeps a pool of readers created by CopyReader, so that every
+  // concurrent caller gets decompression state of its own. The copies share the file position
+  // with this reader, so blob readers must only read their files using IOFile::ReadAt.
+  virtual bool ReadConcurrent(u64 offset, u64 size, u8* out_ptr);
+  bool ReadWiiDecryptedConcurrent(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset);
+
 protected:
   BlobReader() {}
+
+private:
+  std::unique_ptr<BlobReader> AcquireConcurrentReader();
+  void ReleaseConcurrentReader(std::unique_ptr<BlobReader> reader);
+
+  std::mutex m_concurrent_readers_mutex;
+  std::vector<std::unique_ptr<BlobReader>> m_concurrent_readers;
 };
 
 // Provides caching and byte-operation-to-block-operations facilities.
@@ -202,6 +219,7 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback);
+                       int chunk_size, CompressCB callback, ChunkStore* chunk_store = nullptr,
+                       bool zstd_dictionary = false);
 
 }  // namespace DiscIO
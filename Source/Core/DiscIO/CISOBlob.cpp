@@ -18,8 +18,7 @@ CISOFileReader::CISOFileReader(File::IOFile file) : m_file(std::move(file))
   m_size = m_file.GetSize();
 
   CISOHeader header;
-  m_file.Seek(0, File::SeekOrigin::Begin);
-  m_file.ReadArray(&header, 1);
+  m_file.ReadAt(&header, sizeof(header), 0);
 
   m_block_size = header.block_size;
 
@@ -31,8 +30,7 @@ CISOFileReader::CISOFileReader(File::IOFile file) : m_file(std::move(file))
 std::unique_ptr<CISOFileReader> CISOFileReader::Create(File::IOFile file)
 {
   CISOHeader header;
-  if (file.Seek(0, File::SeekOrigin::Begin) && file.ReadArray(&header, 1) &&
-      header.magic == CISO_MAGIC)
+  if (file.ReadAt(&header, sizeof(header), 0) && header.magic == CISO_MAGIC)
   {
     return std::unique_ptr<CISOFileReader>(new CISOFileReader(std::move(file)));
   }
@@ -71,12 +69,8 @@ bool CISOFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
       // calculate the base address
       u64 const file_off = CISO_HEADER_SIZE + m_ciso_map[block] * (u64)m_block_size + data_offset;
 
-      if (!(m_file.Seek(file_off, File::SeekOrigin::Begin) &&
-            m_file.ReadArray(out_ptr, bytes_to_read)))
-      {
-        m_file.ClearError();
+      if (!m_file.ReadAt(out_ptr, bytes_to_read, file_off))
         return false;
-      }
     }
     else
     {
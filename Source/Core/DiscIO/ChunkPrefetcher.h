@@ -0,0 +1,243 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/WorkQueueThread.h"
+
+namespace DiscIO
+{
+// Loads chunks of a compressed disc image ahead of time, so that sequential reads (FMVs, streamed
+// audio, level loads) don't have to wait for each chunk to be decompressed on the DVD thread.
+//
+// Call Take whenever the reader switches to a new chunk. Once a few consecutive chunk accesses
+// have been the same distance apart, the next chunks along that pattern are loaded on worker
+// threads using the load function. The worker threads share the reader's file, so the load
+// function (and the reader itself) must only read from it using ReadAt, and the load function must
+// not touch any other state that the reader modifies.
+// The worker threads are only started once a pattern has been detected, so images that are only
+// read randomly don't pay for anything but the pattern tracking.
+//
+// The context passed to Take is handed to the load function unchanged. It can be used to describe
+// the region of the image that the chunks are being read from.
+template <typename T, typename Context = std::monostate>
+class ChunkPrefetcher
+{
+public:
+  // Returns std::nullopt if the chunk can't be loaded or isn't worth loading ahead of time.
+  using LoadFunction =
+      std::function<std::optional<T>(const File::IOFile& file, u64 index, const Context& context)>;
+
+  struct Stats
+  {
+    // Chunks that were taken after they had finished loading
+    u64 hits = 0;
+    // Chunks that were taken while they were still loading
+    u64 late_hits = 0;
+    // Chunks that had not been loaded ahead of time
+    u64 misses = 0;
+    // Chunks that were loaded ahead of time but discarded without being taken
+    u64 wasted = 0;
+  };
+
+  ChunkPrefetcher(const File::IOFile& file, u64 chunk_size, LoadFunction load)
+      : m_file(file), m_load(std::move(load)),
+        m_max_chunks(std::clamp<u64>(PREFETCH_BUFFER_SIZE / std::max<u64>(chunk_size, 1),
+                                     MIN_CHUNKS, MAX_CHUNKS))
+  {
+  }
+
+  ~ChunkPrefetcher()
+  {
+    for (auto& worker : m_workers)
+      worker->Shutdown(true);
+
+    if (m_workers.empty())
+      return;
+
+    for (const auto& [index, entry] : m_entries)
+    {
+      if (entry.ready && entry.data)
+        ++m_stats.wasted;
+    }
+
+    INFO_LOG_FMT(DISCIO, "Prefetcher: {} hits, {} late hits, {} misses, {} wasted", m_stats.hits,
+                 m_stats.late_hits, m_stats.misses, m_stats.wasted);
+  }
+
+  ChunkPrefetcher(const ChunkPrefetcher&) = delete;
+  ChunkPrefetcher& operator=(const ChunkPrefetcher&) = delete;
+
+  // Returns the chunk if it has been loaded ahead of time, waiting for it to finish loading if
+  // necessary. Returns std::nullopt if the caller has to load the chunk itself.
+  std::optional<T> Take(u64 index, const Context& context = {})
+  {
+    std::unique_lock lk(m_mutex);
+
+    std::optional<T> result;
+    auto it = m_entries.find(index);
+    if (it != m_entries.end())
+    {
+      const bool ready = it->second.ready;
+      if (!ready)
+        m_cond.wait(lk, [&] { return it->second.ready; });
+
+      result = std::move(it->second.data);
+      m_entries.erase(it);
+
+      if (result)
+        ++(ready ? m_stats.hits : m_stats.late_hits);
+    }
+
+    if (!result)
+      ++m_stats.misses;
+
+    UpdatePattern(index);
+    Prefetch(index, context);
+
+    return result;
+  }
+
+  Stats GetStats() const
+  {
+    std::lock_guard lk(m_mutex);
+    return m_stats;
+  }
+
+private:
+  static constexpr u64 PREFETCH_BUFFER_SIZE = 16 * 1024 * 1024;
+  static constexpr u64 MIN_CHUNKS = 2;
+  static constexpr u64 MAX_CHUNKS = 64;
+  static constexpr size_t MAX_THREADS = 4;
+
+  // How many accesses in a row need to have the same stride before we start prefetching
+  static constexpr u32 MIN_PATTERN_LENGTH = 3;
+  // Larger strides are treated as random access
+  static constexpr u64 MAX_STRIDE = 8;
+
+  struct Entry
+  {
+    std::optional<T> data;
+    bool ready = false;
+  };
+
+  struct Request
+  {
+    u64 index;
+    Context context;
+  };
+
+  void UpdatePattern(u64 index)
+  {
+    const u64 stride = index - m_last_index;
+    if (m_pattern_length != 0 && index > m_last_index && stride == m_stride)
+    {
+      ++m_pattern_length;
+    }
+    else
+    {
+      m_stride = index > m_last_index && stride <= MAX_STRIDE ? stride : 0;
+      m_pattern_length = 1;
+    }
+
+    m_last_index = index;
+  }
+
+  void Prefetch(u64 index, const Context& context)
+  {
+    if (m_stride == 0 || m_pattern_length < MIN_PATTERN_LENGTH)
+      return;
+
+    const auto is_upcoming = [&](u64 i) {
+      return i > index && (i - index) % m_stride == 0 && (i - index) / m_stride <= m_max_chunks;
+    };
+
+    // Chunks which are still loading are kept even if they aren't upcoming, since the worker
+    // thread is going to store its result in them
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+      if (it->second.ready && !is_upcoming(it->first))
+      {
+        if (it->second.data)
+          ++m_stats.wasted;
+        it = m_entries.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    for (u64 i = 1; i <= m_max_chunks && m_entries.size() < m_max_chunks; ++i)
+    {
+      const u64 next_index = index + i * m_stride;
+      if (m_entries.contains(next_index))
+        continue;
+
+      if (m_workers.empty())
+        StartWorkers();
+
+      m_entries.emplace(next_index, Entry{});
+      m_workers[m_next_worker]->Push(Request{next_index, context});
+      m_next_worker = (m_next_worker + 1) % m_workers.size();
+    }
+  }
+
+  void StartWorkers()
+  {
+    const size_t thread_count =
+        std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, MAX_THREADS);
+
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+      auto worker = std::make_unique<Common::WorkQueueThread<Request>>();
+      worker->Reset("Disc Prefetch",
+                    [this](Request request) { LoadChunk(request.index, request.context); });
+      m_workers.push_back(std::move(worker));
+    }
+  }
+
+  void LoadChunk(u64 index, const Context& context)
+  {
+    std::optional<T> data = m_load(m_file, index, context);
+
+    std::lock_guard lk(m_mutex);
+    Entry& entry = m_entries[index];
+    entry.data = std::move(data);
+    entry.ready = true;
+    m_cond.notify_all();
+  }
+
+  const File::IOFile& m_file;
+  LoadFunction m_load;
+  const u64 m_max_chunks;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::map<u64, Entry> m_entries;
+  Stats m_stats;
+
+  u64 m_last_index = 0;
+  u64 m_stride = 0;
+  u32 m_pattern_length = 0;
+
+  std::vector<std::unique_ptr<Common::WorkQueueThread<Request>>> m_workers;
+  size_t m_next_worker = 0;
+};
+
+}  // namespace DiscIO
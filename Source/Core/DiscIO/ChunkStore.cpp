@@ -0,0 +1,96 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/ChunkStore.h"
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace DiscIO
+{
+static u32 GetOwnProcessId()
+{
+#ifdef _WIN32
+  return GetCurrentProcessId();
+#else
+  return getpid();
+#endif
+}
+
+ChunkStore::ChunkStore(std::string directory) : m_directory(std::move(directory))
+{
+}
+
+std::string ChunkStore::GetPath(const Common::SHA1::Digest& key) const
+{
+  // Use the first byte as a subdirectory to keep the number of files per directory manageable
+  const std::string hex = Common::BytesToHexString(key);
+  return fmt::format("{}/{}/{}", m_directory, hex.substr(0, 2), hex.substr(2));
+}
+
+std::optional<std::vector<u8>> ChunkStore::Load(const Common::SHA1::Digest& key)
+{
+  File::IOFile file(GetPath(key), "rb");
+  if (!file)
+  {
+    ++m_misses;
+    return std::nullopt;
+  }
+
+  std::vector<u8> data(file.GetSize());
+  if (!file.ReadBytes(data.data(), data.size()))
+  {
+    ++m_misses;
+    return std::nullopt;
+  }
+
+  ++m_hits;
+  return data;
+}
+
+void ChunkStore::Store(const Common::SHA1::Digest& key, const std::vector<u8>& data)
+{
+  const std::string path = GetPath(key);
+  if (!File::CreateFullPath(path))
+    return;
+
+  // Write to a temporary file first, so that other conversions using the same chunk store
+  // never see a partially written entry. The name is unique to this thread of this process, since
+  // other processes may be storing the same chunk at the same time.
+  const std::string temp_path =
+      fmt::format("{}.{}.{}.tmp", path, GetOwnProcessId(),
+                  std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file || !file.WriteBytes(data.data(), data.size()))
+    {
+      WARN_LOG_FMT(DISCIO, "Failed to write to chunk store: {}", temp_path);
+      file.Close();
+      File::Delete(temp_path);
+      return;
+    }
+  }
+
+  if (!File::Rename(temp_path, path))
+    File::Delete(temp_path);
+}
+
+}  // namespace DiscIO
@@ -0,0 +1,42 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+
+namespace DiscIO
+{
+// A directory of previously compressed data, addressed by a hash of everything that determines
+// what the compressed data looks like. Converting an image with a chunk store lets data that was
+// compressed while converting an earlier image (another revision, a regional variant, or simply
+// the same image) be copied instead of compressed again.
+//
+// Every entry is stored in a file of its own, so a chunk store can be shared between threads and
+// between several conversions running at the same time.
+class ChunkStore
+{
+public:
+  explicit ChunkStore(std::string directory);
+
+  std::optional<std::vector<u8>> Load(const Common::SHA1::Digest& key);
+  void Store(const Common::SHA1::Digest& key, const std::vector<u8>& data);
+
+  u64 GetHits() const { return m_hits.load(); }
+  u64 GetMisses() const { return m_misses.load(); }
+
+private:
+  std::string GetPath(const Common::SHA1::Digest& key) const;
+
+  std::string m_directory;
+  std::atomic<u64> m_hits = 0;
+  std::atomic<u64> m_misses = 0;
+};
+
+}  // namespace DiscIO
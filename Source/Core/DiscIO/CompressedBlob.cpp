@@ -7,8 +7,10 @@
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <zlib.h>
@@ -38,26 +40,41 @@ CompressedBlobReader::CompressedBlobReader(File::IOFile file, const std::string&
     : m_file(std::move(file)), m_file_name(filename)
 {
   m_file_size = m_file.GetSize();
-  m_file.Seek(0, File::SeekOrigin::Begin);
-  m_file.ReadArray(&m_header, 1);
+  m_file.ReadAt(&m_header, sizeof(m_header), 0);
 
   SetSectorSize(m_header.block_size);
 
   // cache block pointers and hashes
+  const u64 block_pointers_offset = sizeof(CompressedBlobHeader);
   m_block_pointers.resize(m_header.num_blocks);
-  m_file.ReadArray(m_block_pointers.data(), m_header.num_blocks);
+  m_file.ReadAt(m_block_pointers.data(), sizeof(u64) * m_header.num_blocks,
+                block_pointers_offset);
+  const u64 hashes_offset = block_pointers_offset + sizeof(u64) * m_header.num_blocks;
   m_hashes.resize(m_header.num_blocks);
-  m_file.ReadArray(m_hashes.data(), m_header.num_blocks);
+  m_file.ReadAt(m_hashes.data(), sizeof(u32) * m_header.num_blocks, hashes_offset);
 
-  m_data_offset = (sizeof(CompressedBlobHeader)) +
-                  (sizeof(u64)) * m_header.num_blocks     // skip block pointers
-                  + (sizeof(u32)) * m_header.num_blocks;  // skip hashes
+  m_data_offset = hashes_offset + sizeof(u32) * m_header.num_blocks;
 
   // A compressed block is never ever longer than a decompressed block, so just header.block_size
   // should be fine.
   // I still add some safety margin.
   const u32 zlib_buffer_size = m_header.block_size + 64;
   m_zlib_buffer.resize(zlib_buffer_size);
+
+  m_prefetcher = std::make_unique<ChunkPrefetcher<std::vector<u8>>>(
+      m_file, m_header.block_size,
+      [this, zlib_buffer_size](const File::IOFile& file, u64 block_num,
+                               std::monostate) -> std::optional<std::vector<u8>> {
+        if (block_num >= m_header.num_blocks)
+          return std::nullopt;
+
+        std::vector<u8> zlib_buffer(zlib_buffer_size);
+        std::vector<u8> block(m_header.block_size);
+        if (!ReadBlock(file, &zlib_buffer, block_num, block.data()))
+          return std::nullopt;
+
+        return block;
+      });
 }
 
 std::unique_ptr<CompressedBlobReader> CompressedBlobReader::Create(File::IOFile file,
@@ -93,6 +110,20 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
 }
 
 bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  if (std::optional<std::vector<u8>> block = m_prefetcher->Take(block_num))
+  {
+    std::copy(block->begin(), block->end(), out_ptr);
+    return true;
+  }
+
+  return ReadBlock(m_file, &m_zlib_buffer, block_num, out_ptr);
+}
+
+// This is called on the prefetcher's worker threads too, so it must not modify the reader or use
+// the file position
+bool CompressedBlobReader::ReadBlock(const File::IOFile& file, std::vector<u8>* zlib_buffer,
+                                     u64 block_num, u8* out_ptr) const
 {
   bool uncompressed = false;
   u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
@@ -107,19 +138,17 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
   }
 
   // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
-  memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
+  memset(&(*zlib_buffer)[comp_block_size], 0, zlib_buffer->size() - comp_block_size);
 
-  m_file.Seek(offset, File::SeekOrigin::Begin);
-  if (!m_file.ReadBytes(m_zlib_buffer.data(), comp_block_size))
+  if (!file.ReadAt(zlib_buffer->data(), comp_block_size, offset))
   {
     ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
                   m_file_name);
-    m_file.ClearError();
     return false;
   }
 
   // First, check hash.
-  const u32 block_hash = Common::HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  const u32 block_hash = Common::HashAdler32(zlib_buffer->data(), comp_block_size);
   if (block_hash != m_hashes[block_num])
   {
     ERROR_LOG_FMT(DISCIO,
@@ -130,12 +159,12 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 
   if (uncompressed)
   {
-    std::copy(m_zlib_buffer.begin(), m_zlib_buffer.begin() + comp_block_size, out_ptr);
+    std::copy(zlib_buffer->begin(), zlib_buffer->begin() + comp_block_size, out_ptr);
   }
   else
   {
     z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
+    z.next_in = zlib_buffer->data();
     z.avail_in = comp_block_size;
     if (z.avail_in > m_header.block_size)
     {
@@ -389,13 +418,8 @@ bool ConvertToGCZ(BlobReader* infile, const std::string& infile_path,
 
 bool IsGCZBlob(File::IOFile& file)
 {
-  const u64 position = file.Tell();
-  if (!file.Seek(0, File::SeekOrigin::Begin))
-    return false;
   CompressedBlobHeader header;
-  bool is_gcz = file.ReadArray(&header, 1) && header.magic_cookie == GCZ_MAGIC;
-  file.Seek(position, File::SeekOrigin::Begin);
-  return is_gcz;
+  return file.ReadAt(&header, sizeof(header), 0) && header.magic_cookie == GCZ_MAGIC;
 }
 
 }  // namespace DiscIO
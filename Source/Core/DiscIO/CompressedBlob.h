@@ -19,6 +19,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/ChunkPrefetcher.h"
 
 namespace DiscIO
 {
@@ -67,6 +68,9 @@ public:
 private:
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  bool ReadBlock(const File::IOFile& file, std::vector<u8>* zlib_buffer, u64 block_num,
+                 u8* out_ptr) const;
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -75,6 +79,9 @@ private:
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
   std::string m_file_name;
+
+  // Declared last so that its worker threads are stopped before anything they use is destroyed
+  std::unique_ptr<ChunkPrefetcher<std::vector<u8>>> m_prefetcher;
 };
 
 }  // namespace DiscIO
@@ -6,19 +6,24 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <filesystem>
 #include <locale>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/ChunkFile.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
@@ -97,10 +102,12 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer, DirectoryBlobReade
     if (std::holds_alternative<ContentFile>(m_content_source))
     {
       const auto& content = std::get<ContentFile>(m_content_source);
-      File::IOFile file(content.m_filename, "rb");
-      if (!file.Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
-          !file.ReadBytes(*buffer, bytes_to_read))
+      File::IOFile* file = blob->OpenContentFile(content.m_filename, content.m_offset + m_size);
+      if (!file || !file->Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
+          !file->ReadBytes(*buffer, bytes_to_read))
       {
+        if (file)
+          file->ClearError();
         return false;
       }
     }
@@ -478,14 +485,54 @@ DirectoryBlobReader::DirectoryBlobReader(
 DirectoryBlobReader::DirectoryBlobReader(const DirectoryBlobReader& rhs)
     : m_gamecube_pseudopartition(rhs.m_gamecube_pseudopartition),
       m_nonpartition_contents(rhs.m_nonpartition_contents), m_partitions(rhs.m_partitions),
-      m_encryption_cache(this), m_is_wii(rhs.m_is_wii), m_encrypted(rhs.m_encrypted),
-      m_data_size(rhs.m_data_size),
+      m_encryption_cache(this, rhs.m_encryption_cache), m_is_wii(rhs.m_is_wii),
+      m_encrypted(rhs.m_encrypted), m_data_size(rhs.m_data_size),
       m_wrapped_volume(rhs.m_wrapped_volume ?
                            CreateDisc(rhs.m_wrapped_volume->GetBlobReader().CopyReader()) :
                            nullptr)
 {
 }
 
+File::IOFile* DirectoryBlobReader::OpenContentFile(const std::string& path, u64 required_size)
+{
+  constexpr size_t MAX_OPEN_FILES = 16;
+
+  const auto it = std::find_if(m_open_files.begin(), m_open_files.end(),
+                               [&path](const auto& open_file) { return open_file.first == path; });
+  if (it != m_open_files.end())
+  {
+    m_open_files.splice(m_open_files.begin(), m_open_files, it);
+    return &m_open_files.front().second;
+  }
+
+  File::IOFile file(path, "rb");
+  if (!file)
+    return nullptr;
+
+  if (file.GetSize() < required_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "{} has been modified after the FST was built. Reboot the game.", path);
+    InvalidateFSTCaches();
+  }
+
+  if (m_open_files.size() >= MAX_OPEN_FILES)
+    m_open_files.pop_back();
+  m_open_files.emplace_front(path, std::move(file));
+  return &m_open_files.front().second;
+}
+
+void DirectoryBlobReader::InvalidateFSTCaches() const
+{
+  const auto invalidate = [](const DirectoryBlobPartition& partition) {
+    if (!partition.GetFSTCachePath().empty())
+      File::Delete(partition.GetFSTCachePath());
+  };
+
+  invalidate(m_gamecube_pseudopartition);
+  for (const auto& [address, partition] : m_partitions)
+    invalidate(partition);
+}
+
 bool DirectoryBlobReader::Read(u64 offset, u64 length, u8* buffer)
 {
   if (offset + length > m_data_size)
@@ -1059,6 +1106,137 @@ u64 DirectoryBlobPartition::SetDOL(FSTBuilderNode dol_node, u64 dol_address,
   return Common::AlignUp(dol_address + dol_node.m_size + 0x20, 0x20ull);
 }
 
+// Scanning the files of an extracted game means looking up the size of every single file, which
+// can take seconds for games with tens of thousands of files. The result of the scan is cached
+// along with the modification time of every directory, which changes whenever a file in it is
+// added, removed or renamed, so validating the cache only takes one lookup per directory. A file
+// that shrinks in place can't be read in full anymore, which is instead detected when it's opened
+// and invalidates the cache for the next boot.
+constexpr u32 FST_CACHE_REVISION = 3;
+
+static std::string GetFSTCachePath(const std::string& directory)
+{
+  return File::GetUserPath(D_CACHE_IDX) + "DirectoryBlob" DIR_SEP +
+         Common::BytesToHexString(Common::SHA1::CalculateDigest(directory)) + ".cache";
+}
+
+static bool GetDirectoryTimes(const File::FSTEntry& directory, std::vector<s64>* times)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(StringToPath(directory.physicalName), error);
+  if (error)
+    return false;
+
+  times->push_back(static_cast<s64>(time.time_since_epoch().count()));
+
+  for (const File::FSTEntry& child : directory.children)
+  {
+    if (child.isDirectory && !GetDirectoryTimes(child, times))
+      return false;
+  }
+
+  return true;
+}
+
+static void DoFSTEntry(PointerWrap& p, File::FSTEntry& entry)
+{
+  p.Do(entry.isDirectory);
+  p.Do(entry.size);
+  p.Do(entry.physicalName);
+  p.Do(entry.virtualName);
+  p.DoEachElement(entry.children, DoFSTEntry);
+}
+
+static void DoFSTCache(PointerWrap& p, std::string* directory, std::vector<s64>* times,
+                       File::FSTEntry* root)
+{
+  u32 revision = FST_CACHE_REVISION;
+  p.Do(revision);
+  if (p.IsReadMode() && revision != FST_CACHE_REVISION)
+  {
+    p.SetMeasureMode();
+    return;
+  }
+
+  p.Do(*directory);
+  p.Do(*times);
+  DoFSTEntry(p, *root);
+}
+
+static std::optional<File::FSTEntry> LoadFSTCache(const std::string& cache_path,
+                                                  const std::string& directory)
+{
+  File::IOFile file(cache_path, "rb");
+  std::vector<u8> buffer(file.GetSize());
+  if (buffer.empty() || !file.ReadBytes(buffer.data(), buffer.size()))
+    return std::nullopt;
+
+  std::string cached_directory;
+  std::vector<s64> cached_times;
+  File::FSTEntry root;
+
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  DoFSTCache(p, &cached_directory, &cached_times, &root);
+  if (!p.IsReadMode() || cached_directory != directory)
+    return std::nullopt;
+
+  std::vector<s64> times;
+  if (!GetDirectoryTimes(root, &times) || times != cached_times)
+    return std::nullopt;
+
+  return root;
+}
+
+static bool SaveFSTCache(const std::string& cache_path, std::string directory,
+                         std::vector<s64> times, File::FSTEntry* root)
+{
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  DoFSTCache(p_measure, &directory, &times, root);
+  const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+
+  std::vector<u8> buffer(buffer_size);
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+  DoFSTCache(p, &directory, &times, root);
+
+  if (!File::CreateFullPath(cache_path))
+    return false;
+
+  File::IOFile file(cache_path, "wb");
+  return file.WriteBytes(buffer.data(), buffer.size());
+}
+
+static File::FSTEntry ScanDirectoryTreeCached(const std::string& directory,
+                                              std::string* cache_path_out)
+{
+  const std::string cache_path = GetFSTCachePath(directory);
+
+  if (std::optional<File::FSTEntry> cached = LoadFSTCache(cache_path, directory))
+  {
+    *cache_path_out = cache_path;
+    return std::move(*cached);
+  }
+
+  File::FSTEntry root = File::ScanDirectoryTree(directory, true);
+
+  // If the modification times can't be read (like for Android content URIs), the scan can't be
+  // validated later, so don't cache it
+  std::vector<s64> times;
+  if (GetDirectoryTimes(root, &times) &&
+      SaveFSTCache(cache_path, directory, std::move(times), &root))
+  {
+    *cache_path_out = cache_path;
+  }
+  else
+  {
+    cache_path_out->clear();
+  }
+
+  return root;
+}
+
 static std::vector<FSTBuilderNode> ConvertFSTEntriesToBuilderNodes(const File::FSTEntry& parent)
 {
   std::vector<FSTBuilderNode> nodes;
@@ -1084,7 +1262,8 @@ static std::vector<FSTBuilderNode> ConvertFSTEntriesToBuilderNodes(const File::F
 void DirectoryBlobPartition::BuildFSTFromFolder(const std::string& fst_root_path, u64 fst_address,
                                                 std::vector<u8>* disc_header)
 {
-  auto nodes = ConvertFSTEntriesToBuilderNodes(File::ScanDirectoryTree(fst_root_path, true));
+  auto nodes =
+      ConvertFSTEntriesToBuilderNodes(ScanDirectoryTreeCached(fst_root_path, &m_fst_cache_path));
   BuildFST(std::move(nodes), fst_address, disc_header);
 }
 
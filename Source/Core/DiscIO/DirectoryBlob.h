@@ -6,16 +6,19 @@
 #include <array>
 #include <cstddef>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/WiiEncryptionCache.h"
@@ -23,7 +26,6 @@
 namespace File
 {
 struct FSTEntry;
-class IOFile;
 }  // namespace File
 
 namespace DiscIO
@@ -205,6 +207,9 @@ public:
   const std::array<u8, VolumeWii::AES_KEY_SIZE>& GetKey() const { return m_key; }
   void SetKey(std::array<u8, VolumeWii::AES_KEY_SIZE> key) { m_key = key; }
 
+  // Empty if the files of this partition weren't scanned through the FST cache
+  const std::string& GetFSTCachePath() const { return m_fst_cache_path; }
+
 private:
   void SetDiscType(std::optional<bool> is_wii, const std::vector<u8>& disc_header);
   void SetBI2FromFile(const std::string& bi2_path);
@@ -236,6 +241,7 @@ private:
   std::array<u8, VolumeWii::AES_KEY_SIZE> m_key{};
 
   std::string m_root_directory;
+  std::string m_fst_cache_path;
   bool m_is_wii = false;
   // GameCube has no shift, Wii has 2 bit shift
   u32 m_address_shift = 0;
@@ -313,6 +319,11 @@ private:
 
   DiscIO::VolumeDisc* GetWrappedVolume() { return m_wrapped_volume.get(); }
 
+  // Returns a handle to the file, opening it if it isn't already open. required_size is used to
+  // detect files whose size has changed since the FST was built.
+  File::IOFile* OpenContentFile(const std::string& path, u64 required_size);
+  void InvalidateFSTCaches() const;
+
   // For GameCube:
   DirectoryBlobPartition m_gamecube_pseudopartition;
 
@@ -327,6 +338,10 @@ private:
   u64 m_data_size;
 
   std::unique_ptr<DiscIO::VolumeDisc> m_wrapped_volume;
+
+  // Games tend to read a file in many small pieces, so the most recently used files are kept open.
+  // Most recently used first.
+  std::list<std::pair<std::string, File::IOFile>> m_open_files;
 };
 
 }  // namespace DiscIO
@@ -65,7 +65,7 @@ bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u6
 
     std::vector<u8> buffer(read_size);
 
-    if (!volume.Read(offset, read_size, buffer.data(), partition))
+    if (!volume.ReadInParallel(offset, read_size, buffer.data(), partition))
       return false;
 
     if (!f.WriteBytes(buffer.data(), read_size))
@@ -18,6 +18,7 @@ namespace DiscIO
 PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
+  m_map = MappedFile::Map(m_file, m_size);
 }
 
 std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
@@ -35,15 +36,19 @@ std::unique_ptr<BlobReader> PlainFileReader::CopyReader() const
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
-  if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out_ptr, nbytes))
-  {
-    return true;
-  }
-  else
-  {
-    m_file.ClearError();
-    return false;
-  }
+  if (m_map.IsMapped())
+    return m_map.Read(offset, nbytes, out_ptr);
+
+  return m_file.ReadAt(out_ptr, nbytes, offset);
+}
+
+bool PlainFileReader::ReadConcurrent(u64 offset, u64 nbytes, u8* out_ptr)
+{
+  if (m_map.IsMapped())
+    return m_map.ReadConcurrent(offset, nbytes, out_ptr);
+
+  // Read doesn't use the file position, so no duplicate file handle is needed
+  return m_file.ReadAt(out_ptr, nbytes, offset);
 }
 
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
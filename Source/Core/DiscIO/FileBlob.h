@@ -10,6 +10,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/MappedFile.h"
 
 namespace DiscIO
 {
@@ -31,12 +32,14 @@ public:
   std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
 
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+  bool ReadConcurrent(u64 offset, u64 nbytes, u8* out_ptr) override;
 
 private:
   PlainFileReader(File::IOFile file);
 
   File::IOFile m_file;
   u64 m_size;
+  MappedFile m_map;
 };
 
 }  // namespace DiscIO
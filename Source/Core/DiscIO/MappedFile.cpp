@@ -0,0 +1,178 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/MappedFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/vfs.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+#include <sys/mount.h>
+#include <sys/param.h>
+#endif
+
+namespace DiscIO
+{
+// How far ahead of a sequential reader the OS is asked to fetch data
+constexpr u64 READ_AHEAD_SIZE = 4 * 1024 * 1024;
+
+#ifndef _WIN32
+static bool IsOnLocalFilesystem(int fd)
+{
+#if defined(__linux__)
+  struct statfs buf;
+  if (fstatfs(fd, &buf) != 0)
+    return false;
+
+  switch (static_cast<u32>(buf.f_type))
+  {
+  case 0x6969:      // NFS
+  case 0x517B:      // SMB
+  case 0xFF534D42:  // CIFS
+  case 0xFE534D42:  // SMB2
+  case 0x01021997:  // 9P
+  case 0x00C36400:  // Ceph
+  case 0x5346414F:  // AFS
+  case 0x65735546:  // FUSE (sshfs and similar)
+    return false;
+  default:
+    return true;
+  }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+  struct statfs buf;
+  return fstatfs(fd, &buf) == 0 && (buf.f_flags & MNT_LOCAL) != 0;
+#else
+  return false;
+#endif
+}
+#endif
+
+MappedFile::~MappedFile()
+{
+  Unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)),
+      m_next_sequential_offset(other.m_next_sequential_offset),
+      m_read_ahead_end(other.m_read_ahead_end)
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this != &other)
+  {
+    Unmap();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_next_sequential_offset = other.m_next_sequential_offset;
+    m_read_ahead_end = other.m_read_ahead_end;
+  }
+  return *this;
+}
+
+MappedFile MappedFile::Map(File::IOFile& file, u64 size)
+{
+#ifdef _WIN32
+  // Reading from a view whose backing file can't be read raises a structured exception rather than
+  // failing the read, so keep using regular reads on Windows.
+  return {};
+#else
+  if constexpr (sizeof(void*) < sizeof(u64))
+    return {};
+
+  if (!file.IsOpen() || size == 0)
+    return {};
+
+  const int fd = fileno(file.GetHandle());
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || static_cast<u64>(st.st_size) < size)
+    return {};
+
+  if (!IsOnLocalFilesystem(fd))
+  {
+    INFO_LOG_FMT(DISCIO, "Not memory-mapping disc image on non-local filesystem");
+    return {};
+  }
+
+  void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED)
+  {
+    WARN_LOG_FMT(DISCIO, "Failed to memory-map disc image: {}", strerror(errno));
+    return {};
+  }
+
+  return MappedFile(static_cast<u8*>(data), size);
+#endif
+}
+
+void MappedFile::Unmap()
+{
+#ifndef _WIN32
+  if (m_data)
+    munmap(m_data, m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+bool MappedFile::Read(u64 offset, u64 nbytes, u8* out_ptr)
+{
+  if (!ReadConcurrent(offset, nbytes, out_ptr))
+    return false;
+
+  const u64 end_offset = offset + nbytes;
+  if (offset == m_next_sequential_offset)
+    ReadAhead(end_offset);
+  else
+    m_read_ahead_end = 0;
+  m_next_sequential_offset = end_offset;
+
+  return true;
+}
+
+bool MappedFile::ReadConcurrent(u64 offset, u64 nbytes, u8* out_ptr) const
+{
+  if (!m_data || offset > m_size || nbytes > m_size - offset)
+    return false;
+
+  std::memcpy(out_ptr, m_data + offset, nbytes);
+  return true;
+}
+
+void MappedFile::ReadAhead(u64 end_offset)
+{
+#ifndef _WIN32
+  // Issue a new hint once the reader is halfway through the data requested by the last one
+  if (end_offset + READ_AHEAD_SIZE / 2 <= m_read_ahead_end || end_offset >= m_size)
+    return;
+
+  static const u64 page_size = static_cast<u64>(sysconf(_SC_PAGESIZE));
+
+  const u64 start = std::max(end_offset, m_read_ahead_end) & ~(page_size - 1);
+  const u64 end = std::min(end_offset + READ_AHEAD_SIZE, m_size);
+  if (start < end)
+    madvise(m_data + start, end - start, MADV_WILLNEED);
+
+  m_read_ahead_end = end;
+#endif
+}
+
+}  // namespace DiscIO
@@ -0,0 +1,51 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace DiscIO
+{
+// A read-only view of a whole file mapped into memory. Reading from it copies straight out of the
+// page cache instead of going through a seek and a read syscall for every request.
+//
+// Mapping is only attempted where it's safe and worthwhile: on 64-bit hosts (so that large disc
+// images fit in the address space) and for regular files on local filesystems (since an I/O error
+// while accessing a mapping can't be reported as a failed read). Callers are expected to keep
+// reading through the file normally if the file isn't mapped.
+class MappedFile final
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Returns an unmapped MappedFile if the file can't or shouldn't be mapped.
+  static MappedFile Map(File::IOFile& file, u64 size);
+
+  bool IsMapped() const { return m_data != nullptr; }
+
+  // Also asks the OS to read ahead when the reads look sequential, so not thread-safe.
+  bool Read(u64 offset, u64 nbytes, u8* out_ptr);
+  bool ReadConcurrent(u64 offset, u64 nbytes, u8* out_ptr) const;
+
+private:
+  MappedFile(u8* data, u64 size) : m_data(data), m_size(size) {}
+
+  void Unmap();
+  void ReadAhead(u64 end_offset);
+
+  u8* m_data = nullptr;
+  u64 m_size = 0;
+
+  u64 m_next_sequential_offset = 0;
+  u64 m_read_ahead_end = 0;
+};
+
+}  // namespace DiscIO
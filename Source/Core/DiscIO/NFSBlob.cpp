@@ -136,11 +136,8 @@ std::unique_ptr<NFSFileReader> NFSFileReader::Create(File::IOFile first_file,
     return nullptr;
 
   NFSHeader header;
-  if (!first_file.Seek(0, File::SeekOrigin::Begin) || !first_file.ReadArray(&header, 1) ||
-      header.magic != NFS_MAGIC)
-  {
+  if (!first_file.ReadAt(&header, sizeof(header), 0) || header.magic != NFS_MAGIC)
     return nullptr;
-  }
 
   std::vector<NFSLBARange> lba_ranges = GetLBARanges(header);
 
@@ -217,33 +214,27 @@ bool NFSFileReader::ReadEncryptedBlock(u64 physical_block_index)
     constexpr size_t PART_1_SIZE = BLOCK_SIZE - sizeof(NFSHeader);
     constexpr size_t PART_2_SIZE = sizeof(NFSHeader);
 
-    File::IOFile& file_1 = m_files[file_index];
-    File::IOFile& file_2 = m_files[file_index + 1];
+    const File::IOFile& file_1 = m_files[file_index];
+    const File::IOFile& file_2 = m_files[file_index + 1];
 
-    if (!file_1.Seek(sizeof(NFSHeader) + block_in_file * BLOCK_SIZE, File::SeekOrigin::Begin) ||
-        !file_1.ReadBytes(m_current_block_encrypted.data(), PART_1_SIZE))
+    if (!file_1.ReadAt(m_current_block_encrypted.data(), PART_1_SIZE,
+                       sizeof(NFSHeader) + block_in_file * BLOCK_SIZE))
     {
-      file_1.ClearError();
       return false;
     }
 
-    if (!file_2.Seek(0, File::SeekOrigin::Begin) ||
-        !file_2.ReadBytes(m_current_block_encrypted.data() + PART_1_SIZE, PART_2_SIZE))
-    {
-      file_2.ClearError();
+    if (!file_2.ReadAt(m_current_block_encrypted.data() + PART_1_SIZE, PART_2_SIZE, 0))
       return false;
-    }
   }
   else
   {
     // Normal case. The read is offset by 0x200 bytes, but it's all within one file.
 
-    File::IOFile& file = m_files[file_index];
+    const File::IOFile& file = m_files[file_index];
 
-    if (!file.Seek(sizeof(NFSHeader) + block_in_file * BLOCK_SIZE, File::SeekOrigin::Begin) ||
-        !file.ReadBytes(m_current_block_encrypted.data(), BLOCK_SIZE))
+    if (!file.ReadAt(m_current_block_encrypted.data(), BLOCK_SIZE,
+                     sizeof(NFSHeader) + block_in_file * BLOCK_SIZE))
     {
-      file.ClearError();
       return false;
     }
   }
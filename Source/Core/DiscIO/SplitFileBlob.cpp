@@ -3,6 +3,7 @@
 
 #include "DiscIO/SplitFileBlob.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -21,8 +22,11 @@ SplitPlainFileReader::SplitPlainFileReader(std::vector<SingleFile> files)
     : m_files(std::move(files))
 {
   m_size = 0;
-  for (const auto& f : m_files)
+  for (auto& f : m_files)
+  {
+    f.map = MappedFile::Map(f.file, f.size);
     m_size += f.size;
+  }
 }
 
 std::unique_ptr<SplitPlainFileReader> SplitPlainFileReader::Create(std::string_view first_file_path)
@@ -82,9 +86,13 @@ bool SplitPlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
       auto& f = file.file;
       const u64 seek_offset = current_offset - file.offset;
       const u64 current_read = std::min(file.size - seek_offset, rest);
-      if (!f.Seek(seek_offset, File::SeekOrigin::Begin) || !f.ReadBytes(out, current_read))
+      if (file.map.IsMapped())
+      {
+        if (!file.map.Read(seek_offset, current_read, out))
+          return false;
+      }
+      else if (!f.ReadAt(out, current_read, seek_offset))
       {
-        f.ClearError();
         return false;
       }
 
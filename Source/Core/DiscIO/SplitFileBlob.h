@@ -12,6 +12,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/MappedFile.h"
 
 namespace DiscIO
 {
@@ -40,6 +41,7 @@ private:
     File::IOFile file;
     u64 offset;
     u64 size;
+    MappedFile map;
   };
 
   SplitPlainFileReader(std::vector<SingleFile> m_files);
@@ -48,8 +48,7 @@ namespace DiscIO
 std::unique_ptr<TGCFileReader> TGCFileReader::Create(File::IOFile file)
 {
   TGCHeader header;
-  if (file.Seek(0, File::SeekOrigin::Begin) && file.ReadArray(&header, 1) &&
-      header.magic == TGC_MAGIC)
+  if (file.ReadAt(&header, sizeof(header), 0) && header.magic == TGC_MAGIC)
   {
     return std::unique_ptr<TGCFileReader>(new TGCFileReader(std::move(file)));
   }
@@ -59,19 +58,15 @@ std::unique_ptr<TGCFileReader> TGCFileReader::Create(File::IOFile file)
 
 TGCFileReader::TGCFileReader(File::IOFile file) : m_file(std::move(file))
 {
-  m_file.Seek(0, File::SeekOrigin::Begin);
-  m_file.ReadArray(&m_header, 1);
+  m_file.ReadAt(&m_header, sizeof(m_header), 0);
 
   m_size = m_file.GetSize();
 
   const u32 fst_offset = Common::swap32(m_header.fst_real_offset);
   const u32 fst_size = Common::swap32(m_header.fst_size);
   m_fst.resize(fst_size);
-  if (!m_file.Seek(fst_offset, File::SeekOrigin::Begin) ||
-      !m_file.ReadBytes(m_fst.data(), m_fst.size()))
-  {
+  if (!m_file.ReadAt(m_fst.data(), m_fst.size(), fst_offset))
     m_fst.clear();
-  }
 
   constexpr size_t FST_ENTRY_SIZE = 12;
   if (m_fst.size() < FST_ENTRY_SIZE)
@@ -112,8 +107,7 @@ bool TGCFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
   const u32 tgc_header_size = Common::swap32(m_header.tgc_header_size);
 
-  if (m_file.Seek(offset + tgc_header_size, File::SeekOrigin::Begin) &&
-      m_file.ReadBytes(out_ptr, nbytes))
+  if (m_file.ReadAt(out_ptr, nbytes, offset + tgc_header_size))
   {
     const u32 replacement_dol_offset = SubtractBE32(m_header.dol_real_offset, tgc_header_size);
     const u32 replacement_fst_offset = SubtractBE32(m_header.fst_real_offset, tgc_header_size);
@@ -126,7 +120,6 @@ bool TGCFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
     return true;
   }
 
-  m_file.ClearError();
   return false;
 }
 
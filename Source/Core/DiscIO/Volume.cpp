@@ -4,10 +4,13 @@
 #include "DiscIO/Volume.h"
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -68,6 +71,52 @@ void Volume::AddTMDToSyncHash(Common::SHA1::Context* context, const Partition& p
     AddToSyncHash(context, content);
 }
 
+bool Volume::ReadInParallel(u64 offset, u64 length, u8* buffer, const Partition& partition) const
+{
+  // Pieces are aligned to the blocks of the blob so that no block has to be decompressed twice
+  constexpr u64 MIN_PIECE_SIZE = 0x20000;
+  u64 piece_size = std::max(GetBlobReader().GetBlockSize(), MIN_PIECE_SIZE);
+  if (partition != PARTITION_NONE && HasWiiHashes())
+    piece_size = piece_size / VolumeWii::BLOCK_TOTAL_SIZE * VolumeWii::BLOCK_DATA_SIZE;
+
+  // Read the first piece on this thread. Apart from aligning the remaining pieces, this ensures
+  // that lazily loaded partition data is loaded before several threads try to access it.
+  const u64 first_piece_size = std::min(length, piece_size - offset % piece_size);
+  if (!ReadConcurrent(offset, first_piece_size, buffer, partition))
+    return false;
+
+  offset += first_piece_size;
+  length -= first_piece_size;
+  buffer += first_piece_size;
+
+  const u64 piece_count = (length + piece_size - 1) / piece_size;
+  const u64 thread_count =
+      std::min<u64>(piece_count, std::max(1u, std::thread::hardware_concurrency()));
+
+  std::atomic<u64> next_piece = 0;
+  std::atomic<bool> success = true;
+  const auto read_pieces = [&] {
+    for (u64 i = next_piece++; i < piece_count && success.load(); i = next_piece++)
+    {
+      const u64 piece_offset = i * piece_size;
+      const u64 size = std::min(piece_size, length - piece_offset);
+      if (!ReadConcurrent(offset + piece_offset, size, buffer + piece_offset, partition))
+        success = false;
+    }
+  };
+
+  std::vector<std::future<void>> futures;
+  for (u64 i = 1; i < thread_count; ++i)
+    futures.push_back(std::async(std::launch::async, read_pieces));
+
+  read_pieces();
+
+  for (std::future<void>& future : futures)
+    future.wait();
+
+  return success.load();
+}
+
 std::map<Language, std::string> Volume::ReadWiiNames(const std::vector<char16_t>& data)
 {
   std::map<Language, std::string> names;
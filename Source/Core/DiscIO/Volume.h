@@ -48,6 +48,12 @@ public:
   Volume() {}
   virtual ~Volume() {}
   virtual bool Read(u64 offset, u64 length, u8* buffer, const Partition& partition) const = 0;
+  // Thread-safe version of Read. See BlobReader::ReadConcurrent.
+  virtual bool ReadConcurrent(u64 offset, u64 length, u8* buffer,
+                              const Partition& partition) const = 0;
+  // Splits the read into pieces and reads them on several threads at once using ReadConcurrent.
+  // Much faster than Read for large reads from compressed formats.
+  bool ReadInParallel(u64 offset, u64 length, u8* buffer, const Partition& partition) const;
   template <typename T>
   std::optional<T> ReadSwapped(u64 offset, const Partition& partition) const
   {
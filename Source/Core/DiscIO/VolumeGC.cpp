@@ -53,6 +53,14 @@ bool VolumeGC::Read(u64 offset, u64 length, u8* buffer, const Partition& partiti
   return m_reader->Read(offset, length, buffer);
 }
 
+bool VolumeGC::ReadConcurrent(u64 offset, u64 length, u8* buffer, const Partition& partition) const
+{
+  if (partition != PARTITION_NONE)
+    return false;
+
+  return m_reader->ReadConcurrent(offset, length, buffer);
+}
+
 const FileSystem* VolumeGC::GetFileSystem(const Partition& partition) const
 {
   return m_file_system->get();
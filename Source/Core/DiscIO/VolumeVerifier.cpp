@@ -10,6 +10,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 #include <mbedtls/md5.h>
@@ -358,6 +359,7 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
 }
 
 constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
+constexpr u64 MAX_READ_SIZE = 0x2000000;
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -1065,6 +1067,11 @@ void VolumeVerifier::SetUpHashing()
   std::sort(m_groups.begin(), m_groups.end(),
             [](const GroupToVerify& a, const GroupToVerify& b) { return a.offset < b.offset; });
 
+  // Reading several blocks of the blob at once lets ReadInParallel decompress them concurrently
+  const u64 block_size = std::max(m_volume.GetBlobReader().GetBlockSize(), DEFAULT_READ_SIZE);
+  m_read_size = std::clamp<u64>(block_size * std::thread::hardware_concurrency(),
+                                DEFAULT_READ_SIZE, MAX_READ_SIZE);
+
   if (m_hashes_to_calculate.crc32)
     m_crc32_context = Common::StartCRC32();
 
@@ -1105,8 +1112,8 @@ bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
 
   if (bytes_to_read > 0)
   {
-    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, data.data() + bytes_to_copy,
-                       PARTITION_NONE))
+    if (!m_volume.ReadInParallel(m_progress + bytes_to_copy, bytes_to_read,
+                                 data.data() + bytes_to_copy, PARTITION_NONE))
     {
       return false;
     }
@@ -1128,7 +1135,7 @@ void VolumeVerifier::Process()
   IOS::ES::Content content{};
   bool content_read = false;
   bool group_read = false;
-  u64 bytes_to_read = DEFAULT_READ_SIZE;
+  u64 bytes_to_read = m_read_size;
   u64 excess_bytes = 0;
   if (m_content_index < m_content_offsets.size() &&
       m_content_offsets[m_content_index] == m_progress)
@@ -178,6 +178,7 @@ private:
   mbedtls_md5_context m_md5_context{};
   std::unique_ptr<Common::SHA1::Context> m_sha1_context;
 
+  u64 m_read_size = 0;
   u64 m_excess_bytes = 0;
   std::vector<u8> m_data;
   std::future<void> m_crc32_future;
@@ -73,6 +73,14 @@ bool VolumeWAD::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
   return m_reader->Read(offset, length, buffer);
 }
 
+bool VolumeWAD::ReadConcurrent(u64 offset, u64 length, u8* buffer, const Partition& partition) const
+{
+  if (partition != PARTITION_NONE)
+    return false;
+
+  return m_reader->ReadConcurrent(offset, length, buffer);
+}
+
 const FileSystem* VolumeWAD::GetFileSystem(const Partition& partition) const
 {
   // TODO: Implement this?
@@ -29,6 +29,8 @@ public:
   VolumeWAD(std::unique_ptr<BlobReader> reader);
   bool Read(u64 offset, u64 length, u8* buffer,
             const Partition& partition = PARTITION_NONE) const override;
+  bool ReadConcurrent(u64 offset, u64 length, u8* buffer,
+                      const Partition& partition = PARTITION_NONE) const override;
   const FileSystem* GetFileSystem(const Partition& partition = PARTITION_NONE) const override;
   std::optional<u64> GetTitleID(const Partition& partition = PARTITION_NONE) const override;
   const IOS::ES::TicketReader&
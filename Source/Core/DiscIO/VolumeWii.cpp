@@ -240,6 +240,72 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
   return true;
 }
 
+bool VolumeWii::ReadConcurrent(u64 offset, u64 length, u8* buffer,
+                               const Partition& partition) const
+{
+  if (partition == PARTITION_NONE)
+    return m_reader->ReadConcurrent(offset, length, buffer);
+
+  auto it = m_partitions.find(partition);
+  if (it == m_partitions.end())
+    return false;
+  const PartitionDetails& partition_details = it->second;
+
+  const u64 partition_data_offset = partition.offset + *partition_details.data_offset;
+  if (m_has_hashes && m_has_encryption &&
+      m_reader->SupportsReadWiiDecrypted(offset, length, partition_data_offset))
+  {
+    return m_reader->ReadWiiDecryptedConcurrent(offset, length, buffer, partition_data_offset);
+  }
+
+  if (!m_has_hashes)
+    return m_reader->ReadConcurrent(partition_data_offset + offset, length, buffer);
+
+  Common::AES::Context* aes_context = nullptr;
+  if (m_has_encryption)
+  {
+    aes_context = partition_details.key->get();
+    if (!aes_context)
+      return false;
+  }
+
+  // Unlike Read, this can't use m_last_decrypted_block, since other threads may be using it
+  std::vector<u8> read_buffer(BLOCK_TOTAL_SIZE);
+  std::array<u8, BLOCK_DATA_SIZE> block_data;
+
+  while (length > 0)
+  {
+    const u64 block_offset_on_disc =
+        partition_data_offset + offset / BLOCK_DATA_SIZE * BLOCK_TOTAL_SIZE;
+    const u64 data_offset_in_block = offset % BLOCK_DATA_SIZE;
+    const u64 copy_size = std::min(length, BLOCK_DATA_SIZE - data_offset_in_block);
+
+    if (m_has_encryption)
+    {
+      if (!m_reader->ReadConcurrent(block_offset_on_disc, BLOCK_TOTAL_SIZE, read_buffer.data()))
+        return false;
+
+      DecryptBlockData(read_buffer.data(), block_data.data(), aes_context);
+      std::memcpy(buffer, block_data.data() + data_offset_in_block,
+                  static_cast<size_t>(copy_size));
+    }
+    else
+    {
+      if (!m_reader->ReadConcurrent(block_offset_on_disc + BLOCK_HEADER_SIZE + data_offset_in_block,
+                                    copy_size, buffer))
+      {
+        return false;
+      }
+    }
+
+    length -= copy_size;
+    buffer += copy_size;
+    offset += copy_size;
+  }
+
+  return true;
+}
+
 bool VolumeWii::HasWiiHashes() const
 {
   return m_has_hashes;
@@ -60,6 +60,8 @@ public:
   VolumeWii(std::unique_ptr<BlobReader> reader);
   ~VolumeWii();
   bool Read(u64 offset, u64 length, u8* buffer, const Partition& partition) const override;
+  bool ReadConcurrent(u64 offset, u64 length, u8* buffer,
+                      const Partition& partition) const override;
   bool HasWiiHashes() const override;
   bool HasWiiEncryption() const override;
   std::vector<Partition> GetPartitions() const override;
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <functional>
 #include <limits>
 #include <map>
 #include <memory>
@@ -29,6 +30,7 @@
 #include "Common/Swap.h"
 
 #include "DiscIO/Blob.h"
+#include "DiscIO/ChunkStore.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Filesystem.h"
 #include "DiscIO/LaggedFibonacciGenerator.h"
@@ -82,6 +84,15 @@ WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& pa
     : m_file(std::move(file)), m_path(path), m_encryption_cache(this)
 {
   m_valid = Initialize(path);
+
+  if (m_valid)
+  {
+    m_prefetcher = std::make_unique<ChunkPrefetcher<Chunk, GroupRange>>(
+        m_file, Common::swap32(m_header_2.chunk_size),
+        [this](const File::IOFile& file, u64 total_group_index, const GroupRange& range) {
+          return PrefetchGroup(&file, total_group_index, range);
+        });
+  }
 }
 
 template <bool RVZ>
@@ -90,7 +101,7 @@ WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
 {
-  if (!m_file.Seek(0, File::SeekOrigin::Begin) || !m_file.ReadArray(&m_header_1, 1))
+  if (!m_file.ReadAt(&m_header_1, sizeof(m_header_1), 0))
     return false;
 
   if ((!RVZ && m_header_1.magic != WIA_MAGIC) || (RVZ && m_header_1.magic != RVZ_MAGIC))
@@ -126,7 +137,7 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
     return false;
 
   std::vector<u8> header_2(header_2_size);
-  if (!m_file.ReadBytes(header_2.data(), header_2.size()))
+  if (!m_file.ReadAt(header_2.data(), header_2.size(), sizeof(m_header_1)))
     return false;
 
   const auto header_2_actual_hash = Common::SHA1::CalculateDigest(header_2);
@@ -158,13 +169,24 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
     return false;
   }
 
+  // RVZ files compressed with Zstandard may store a dictionary after the end of header 2
+  if (RVZ && m_compression_type == WIARVZCompressionType::Zstd &&
+      header_2_size > sizeof(WIAHeader2))
+  {
+    const std::vector<u8> dictionary(header_2.begin() + sizeof(WIAHeader2), header_2.end());
+    m_zstd_dictionary = std::make_unique<ZstdDecompressionDictionary>(dictionary);
+    if (!m_zstd_dictionary->Get())
+      return false;
+  }
+
   const size_t number_of_partition_entries = Common::swap32(m_header_2.number_of_partition_entries);
   const size_t partition_entry_size = Common::swap32(m_header_2.partition_entry_size);
   std::vector<u8> partition_entries(partition_entry_size * number_of_partition_entries);
-  if (!m_file.Seek(Common::swap64(m_header_2.partition_entries_offset), File::SeekOrigin::Begin))
-    return false;
-  if (!m_file.ReadBytes(partition_entries.data(), partition_entries.size()))
+  if (!m_file.ReadAt(partition_entries.data(), partition_entries.size(),
+                     Common::swap64(m_header_2.partition_entries_offset)))
+  {
     return false;
+  }
 
   const auto partition_entries_actual_hash = Common::SHA1::CalculateDigest(partition_entries);
   if (m_header_2.partition_entries_hash != partition_entries_actual_hash)
@@ -289,7 +311,10 @@ BlobType WIARVZFileReader<RVZ>::GetBlobType() const
 template <bool RVZ>
 std::unique_ptr<BlobReader> WIARVZFileReader<RVZ>::CopyReader() const
 {
-  return Create(m_file.Duplicate("rb"), m_path);
+  std::unique_ptr<WIARVZFileReader> reader = Create(m_file.Duplicate("rb"), m_path);
+  if (reader)
+    reader->m_encryption_cache = WiiEncryptionCache(reader.get(), m_encryption_cache);
+  return reader;
 }
 
 template <bool RVZ>
@@ -500,6 +525,9 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   data_offset -= skipped_data;
   data_size += skipped_data;
 
+  const GroupRange range{chunk_size, data_offset, data_size, group_index, number_of_groups,
+                         exception_lists};
+
   const u64 start_group_index = (*offset - data_offset) / chunk_size;
   for (u64 i = start_group_index; i < number_of_groups && (*size) > 0; ++i)
   {
@@ -536,6 +564,16 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     {
       const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
 
+      if (group_offset_in_file != m_cached_chunk_offset)
+      {
+        std::optional<Chunk> prefetched_chunk = m_prefetcher->Take(total_group_index, range);
+        if (prefetched_chunk)
+        {
+          m_cached_chunk = std::move(*prefetched_chunk);
+          m_cached_chunk_offset = group_offset_in_file;
+        }
+      }
+
       Chunk& chunk =
           ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
                              exception_lists, rvz_packed_size, group_offset_in_data);
@@ -575,6 +613,19 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
   if (offset_in_file == m_cached_chunk_offset)
     return m_cached_chunk;
 
+  m_cached_chunk = CreateChunk(&m_file, offset_in_file, compressed_size, decompressed_size,
+                               compression_type, exception_lists, rvz_packed_size, data_offset);
+  m_cached_chunk_offset = offset_in_file;
+  return m_cached_chunk;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(const File::IOFile* file, u64 offset_in_file,
+                                   u64 compressed_size, u64 decompressed_size,
+                                   WIARVZCompressionType compression_type, u32 exception_lists,
+                                   u32 rvz_packed_size, u64 data_offset) const
+{
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -597,17 +648,62 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                                       m_header_2.compressor_data_size);
     break;
   case WIARVZCompressionType::Zstd:
-    decompressor = std::make_unique<ZstdDecompressor>();
+    decompressor = std::make_unique<ZstdDecompressor>(m_zstd_dictionary.get());
     break;
   }
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(file, offset_in_file, compressed_size, decompressed_size, exception_lists,
+               compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
+}
+
+template <bool RVZ>
+std::optional<typename WIARVZFileReader<RVZ>::Chunk>
+WIARVZFileReader<RVZ>::PrefetchGroup(const File::IOFile* file, u64 total_group_index,
+                                     const GroupRange& range) const
+{
+  if (total_group_index < range.group_index ||
+      total_group_index - range.group_index >= range.number_of_groups ||
+      total_group_index >= m_group_entries.size())
+  {
+    return std::nullopt;
+  }
+
+  // This mirrors the calculations in ReadFromGroups
+  const GroupEntry group = m_group_entries[total_group_index];
+  const u64 group_offset_in_data = (total_group_index - range.group_index) * range.chunk_size;
+  if (group_offset_in_data >= range.data_size)
+    return std::nullopt;
+
+  const u64 chunk_size = std::min(range.chunk_size, range.data_size - group_offset_in_data);
+  u32 group_data_size = Common::swap32(group.data_size);
+
+  WIARVZCompressionType compression_type = m_compression_type;
+  u32 rvz_packed_size = 0;
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  // Groups consisting only of zeroes are cheap to read, so there is nothing to gain
+  if (group_data_size == 0)
+    return std::nullopt;
+
+  const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+
+  Chunk chunk = CreateChunk(file, group_offset_in_file, group_data_size, chunk_size,
+                            compression_type, range.exception_lists, rvz_packed_size,
+                            group_offset_in_data);
+  if (!chunk.DecompressAll())
+    return std::nullopt;
+
+  return chunk;
 }
 
 template <bool RVZ>
@@ -628,10 +724,11 @@ template <bool RVZ>
 WIARVZFileReader<RVZ>::Chunk::Chunk() = default;
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
-                                    u64 decompressed_size, u32 exception_lists,
-                                    bool compressed_exception_lists, u32 rvz_packed_size,
-                                    u64 data_offset, std::unique_ptr<Decompressor> decompressor)
+WIARVZFileReader<RVZ>::Chunk::Chunk(const File::IOFile* file, u64 offset_in_file,
+                                    u64 compressed_size, u64 decompressed_size,
+                                    u32 exception_lists, bool compressed_exception_lists,
+                                    u32 rvz_packed_size, u64 data_offset,
+                                    std::unique_ptr<Decompressor> decompressor)
     : m_decompressor(std::move(decompressor)), m_file(file), m_offset_in_file(offset_in_file),
       m_exception_lists(exception_lists), m_compressed_exception_lists(compressed_exception_lists),
       m_rvz_packed_size(rvz_packed_size), m_data_offset(data_offset)
@@ -651,16 +748,36 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 {
-  if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
-  {
+  if (!m_decompressor || offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
+    return false;
+
+  if (!DecompressUpTo(offset + size))
     return false;
-  }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  if (!m_decompressor || !DecompressUpTo(m_out.data.size() - m_out_bytes_allocated_for_exceptions))
+    return false;
+
+  m_file = nullptr;
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUpTo(u64 end_offset)
+{
+  while (end_offset > GetOutBytesWrittenExcludingExceptions())
   {
+    if (!m_file)
+      return false;
+
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end_offset == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -673,7 +790,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end_offset - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -691,9 +808,8 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
       return false;
     }
 
-    if (!m_file->Seek(m_offset_in_file, File::SeekOrigin::Begin))
-      return false;
-    if (!m_file->ReadBytes(m_in.data.data() + m_in.bytes_written, bytes_to_read))
+    // The prefetcher's worker threads read from the same file, so the file position can't be used
+    if (!m_file->ReadAt(m_in.data.data() + m_in.bytes_written, bytes_to_read, m_offset_in_file))
       return false;
 
     m_offset_in_file += bytes_to_read;
@@ -753,7 +869,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1058,10 +1173,70 @@ std::optional<std::vector<u8>> WIARVZFileReader<RVZ>::Compress(Compressor* compr
   return std::vector<u8>(data, data + size);
 }
 
+template <bool RVZ>
+std::vector<u8>
+WIARVZFileReader<RVZ>::CreateZstdDictionary(BlobReader* infile,
+                                            const std::vector<PartitionEntry>& partition_entries)
+{
+  // Blocks spread evenly over the whole disc are used as samples. Blocks in Wii partitions are
+  // decrypted first, since it's the decrypted data that gets compressed.
+  constexpr u64 NUMBER_OF_SAMPLES = 256;
+
+  const u64 number_of_blocks = infile->GetDataSize() / VolumeWii::BLOCK_TOTAL_SIZE;
+
+  const auto find_partition = [&](u64 offset) -> const PartitionEntry* {
+    for (const PartitionEntry& partition_entry : partition_entries)
+    {
+      for (const PartitionDataEntry& data_entry : partition_entry.data_entries)
+      {
+        const u64 first_sector = Common::swap32(data_entry.first_sector);
+        const u64 end_sector = first_sector + Common::swap32(data_entry.number_of_sectors);
+        if (offset >= first_sector * VolumeWii::BLOCK_TOTAL_SIZE &&
+            offset < end_sector * VolumeWii::BLOCK_TOTAL_SIZE)
+        {
+          return &partition_entry;
+        }
+      }
+    }
+    return nullptr;
+  };
+
+  std::vector<std::vector<u8>> samples;
+  std::vector<u8> buffer(VolumeWii::BLOCK_TOTAL_SIZE);
+  std::optional<u64> last_block;
+  for (u64 i = 0; i < NUMBER_OF_SAMPLES; ++i)
+  {
+    const u64 block = i * number_of_blocks / NUMBER_OF_SAMPLES;
+    if (block == last_block)
+      continue;
+    last_block = block;
+
+    const u64 offset = block * VolumeWii::BLOCK_TOTAL_SIZE;
+    if (!infile->Read(offset, buffer.size(), buffer.data()))
+      return {};
+
+    if (const PartitionEntry* partition_entry = find_partition(offset))
+    {
+      auto aes_context = Common::AES::CreateContextDecrypt(partition_entry->partition_key.data());
+      std::vector<u8> sample(VolumeWii::BLOCK_DATA_SIZE);
+      VolumeWii::DecryptBlockData(buffer.data(), sample.data(), aes_context.get());
+      samples.push_back(std::move(sample));
+    }
+    else
+    {
+      samples.push_back(buffer);
+    }
+  }
+
+  return BuildZstdDictionary(samples, MAX_ZSTD_DICTIONARY_SIZE);
+}
+
 template <bool RVZ>
 void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                                             WIARVZCompressionType compression_type,
-                                            int compression_level, WIAHeader2* header_2)
+                                            int compression_level,
+                                            const std::vector<u8>& zstd_dictionary,
+                                            WIAHeader2* header_2)
 {
   switch (compression_type)
   {
@@ -1092,7 +1267,7 @@ void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compres
     break;
   }
   case WIARVZCompressionType::Zstd:
-    *compressor = std::make_unique<ZstdCompressor>(compression_level);
+    *compressor = std::make_unique<ZstdCompressor>(compression_level, zstd_dictionary);
     break;
   }
 }
@@ -1638,6 +1813,181 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
   return OutputParameters{std::move(output_entries), parameters.bytes_read, parameters.group_index};
 }
 
+// The file system only affects the output of ProcessAndCompress through the offsets and sizes of
+// the files, which RVZPack uses to tell where junk data may start
+static Common::SHA1::Digest GetFileSystemLayoutHash(const FileSystem& file_system)
+{
+  const auto context = Common::SHA1::CreateContext();
+
+  std::vector<u8> data;
+  const std::function<void(const FileInfo&)> add_directory = [&](const FileInfo& directory) {
+    for (const FileInfo& file_info : directory)
+    {
+      if (file_info.IsDirectory())
+      {
+        add_directory(file_info);
+        continue;
+      }
+
+      data.clear();
+      PushBack(&data, file_info.GetOffset());
+      PushBack(&data, file_info.GetSize());
+      context->Update(data);
+    }
+  };
+  add_directory(file_system.GetRoot());
+
+  return context->Finish();
+}
+
+template <bool RVZ>
+Common::SHA1::Digest WIARVZFileReader<RVZ>::GetChunkStoreKey(
+    const CompressParameters& parameters, const std::vector<PartitionEntry>& partition_entries,
+    WIARVZCompressionType compression_type, int compression_level, int chunk_size,
+    const std::optional<Common::SHA1::Digest>& zstd_dictionary_hash,
+    const std::optional<Common::SHA1::Digest>& file_system_hash)
+{
+  // Everything that affects the output of ProcessAndCompress. Increment the version if the output
+  // of ProcessAndCompress or the serialization format changes.
+  constexpr u32 CHUNK_STORE_VERSION = 2;
+
+  std::vector<u8> header;
+  PushBack(&header, RVZ ? RVZ_MAGIC : WIA_MAGIC);
+  PushBack(&header, CHUNK_STORE_VERSION);
+  PushBack(&header, compression_type);
+  PushBack(&header, compression_level);
+  PushBack(&header, chunk_size);
+  if (zstd_dictionary_hash)
+    PushBack(&header, *zstd_dictionary_hash);
+  PushBack(&header, file_system_hash.has_value());
+  if (file_system_hash)
+    PushBack(&header, *file_system_hash);
+  PushBack(&header, parameters.data_entry->is_partition);
+  if (parameters.data_entry->is_partition)
+    PushBack(&header, partition_entries[parameters.data_entry->index].partition_key);
+  PushBack(&header, parameters.data_offset);
+  PushBack(&header, static_cast<u64>(parameters.data.size()));
+
+  const auto context = Common::SHA1::CreateContext();
+  context->Update(header);
+  context->Update(parameters.data);
+  return context->Finish();
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::CanBeStoredInChunkStore(
+    const std::vector<OutputParametersEntry>& entries)
+{
+  // Entries which are reused within an image refer to group entries of that image, and entries
+  // with a reuse ID are cheap to create anyway
+  return std::none_of(entries.begin(), entries.end(), [](const OutputParametersEntry& entry) {
+    return entry.reuse_id || entry.reused_group;
+  });
+}
+
+template <bool RVZ>
+std::vector<u8>
+WIARVZFileReader<RVZ>::SerializeForChunkStore(const std::vector<OutputParametersEntry>& entries)
+{
+  std::vector<u8> data;
+  PushBack(&data, static_cast<u32>(entries.size()));
+  for (const OutputParametersEntry& entry : entries)
+  {
+    PushBack(&data, static_cast<u32>(entry.exception_lists.size()));
+    PushBack(&data, static_cast<u32>(entry.main_data.size()));
+    if constexpr (RVZ)
+    {
+      PushBack(&data, static_cast<u32>(entry.rvz_packed_size));
+      PushBack(&data, static_cast<u8>(entry.compressed));
+    }
+    PushBack(&data, entry.exception_lists.data(),
+             entry.exception_lists.data() + entry.exception_lists.size());
+    PushBack(&data, entry.main_data.data(), entry.main_data.data() + entry.main_data.size());
+  }
+  return data;
+}
+
+template <bool RVZ>
+size_t WIARVZFileReader<RVZ>::GetNumberOfOutputEntries(const CompressParameters& parameters,
+                                                       u64 chunks_per_wii_group,
+                                                       u64 exception_lists_per_chunk)
+{
+  // This mirrors the calculations in ProcessAndCompress
+  if (!parameters.data_entry->is_partition)
+    return 1;
+
+  const u64 blocks = parameters.data.size() / VolumeWii::BLOCK_TOTAL_SIZE;
+  const u64 blocks_per_chunk = chunks_per_wii_group == 1 ?
+                                   exception_lists_per_chunk * VolumeWii::BLOCKS_PER_GROUP :
+                                   VolumeWii::BLOCKS_PER_GROUP / chunks_per_wii_group;
+  return Common::AlignUp(blocks, blocks_per_chunk) / blocks_per_chunk;
+}
+
+template <bool RVZ>
+std::optional<std::vector<typename WIARVZFileReader<RVZ>::OutputParametersEntry>>
+WIARVZFileReader<RVZ>::DeserializeFromChunkStore(const std::vector<u8>& data,
+                                                 size_t expected_entries)
+{
+  size_t position = 0;
+
+  const auto read = [&](void* out, size_t size) {
+    if (data.size() - position < size)
+      return false;
+    std::memcpy(out, data.data() + position, size);
+    position += size;
+    return true;
+  };
+
+  const auto read_vector = [&](std::vector<u8>* out, u32 size) {
+    out->resize(size);
+    return read(out->data(), size);
+  };
+
+  // The count comes from a file on disk, so check it before allocating anything for it
+  u32 number_of_entries;
+  if (!read(&number_of_entries, sizeof(number_of_entries)) ||
+      number_of_entries != expected_entries)
+  {
+    return std::nullopt;
+  }
+
+  std::vector<OutputParametersEntry> entries(number_of_entries);
+  for (OutputParametersEntry& entry : entries)
+  {
+    u32 exception_lists_size;
+    u32 main_data_size;
+    if (!read(&exception_lists_size, sizeof(exception_lists_size)) ||
+        !read(&main_data_size, sizeof(main_data_size)))
+    {
+      return std::nullopt;
+    }
+
+    if constexpr (RVZ)
+    {
+      u32 rvz_packed_size;
+      u8 compressed;
+      if (!read(&rvz_packed_size, sizeof(rvz_packed_size)) ||
+          !read(&compressed, sizeof(compressed)))
+      {
+        return std::nullopt;
+      }
+      entry.rvz_packed_size = rvz_packed_size;
+      entry.compressed = compressed != 0;
+    }
+
+    if (!read_vector(&entry.exception_lists, exception_lists_size) ||
+        !read_vector(&entry.main_data, main_data_size))
+    {
+      return std::nullopt;
+    }
+  }
+
+  if (position != data.size())
+    return std::nullopt;
+
+  return entries;
+}
+
 template <bool RVZ>
 ConversionResultCode WIARVZFileReader<RVZ>::Output(std::vector<OutputParametersEntry>* entries,
                                                    File::IOFile* outfile,
@@ -1735,7 +2085,8 @@ template <bool RVZ>
 ConversionResultCode
 WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                File::IOFile* outfile, WIARVZCompressionType compression_type,
-                               int compression_level, int chunk_size, CompressCB callback)
+                               int compression_level, int chunk_size, CompressCB callback,
+                               ChunkStore* chunk_store, bool zstd_dictionary)
 {
   ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
   ASSERT(chunk_size > 0);
@@ -1771,6 +2122,15 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   group_entries.resize(total_groups);
 
+  std::vector<u8> dictionary;
+  std::optional<Common::SHA1::Digest> dictionary_hash;
+  if (RVZ && zstd_dictionary && compression_type == WIARVZCompressionType::Zstd)
+  {
+    dictionary = CreateZstdDictionary(infile, partition_entries);
+    if (!dictionary.empty())
+      dictionary_hash = Common::SHA1::CalculateDigest(dictionary);
+  }
+
   const size_t partition_entries_size = partition_entries.size() * sizeof(PartitionEntry);
   const size_t raw_data_entries_size = raw_data_entries.size() * sizeof(RawDataEntry);
   const size_t group_entries_size = group_entries.size() * sizeof(GroupEntry);
@@ -1780,8 +2140,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   // fit in that space, we will need to write them at the end of the file instead.
   const u64 headers_size_upper_bound = [&] {
     // 0x100 is added to account for compression overhead (in particular for Purge).
-    u64 upper_bound = sizeof(WIAHeader1) + sizeof(WIAHeader2) + partition_entries_size +
-                      raw_data_entries_size + 0x100;
+    u64 upper_bound = sizeof(WIAHeader1) + sizeof(WIAHeader2) + dictionary.size() +
+                      partition_entries_size + raw_data_entries_size + 0x100;
 
     // Compared to WIA, RVZ adds an extra member to the GroupEntry struct. This added data usually
     // compresses well, so we'll assume the compression ratio for RVZ GroupEntries is 9 / 16 or
@@ -1797,6 +2157,22 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
     return Common::AlignUp(upper_bound, VolumeWii::BLOCK_TOTAL_SIZE);
   }();
 
+  // Only RVZ packing looks at the file systems
+  std::map<const FileSystem*, Common::SHA1::Digest> file_system_hashes;
+  if (RVZ && chunk_store)
+  {
+    for (const FileSystem* file_system : partition_file_systems)
+    {
+      if (file_system && !file_system_hashes.contains(file_system))
+        file_system_hashes.emplace(file_system, GetFileSystemLayoutHash(*file_system));
+    }
+    if (non_partition_file_system)
+    {
+      file_system_hashes.emplace(non_partition_file_system,
+                                 GetFileSystemLayoutHash(*non_partition_file_system));
+    }
+  }
+
   std::vector<u8> buffer;
 
   buffer.resize(headers_size_upper_bound);
@@ -1811,7 +2187,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   std::mutex reusable_groups_mutex;
 
   const auto set_up_compress_thread_state = [&](CompressThreadState* state) {
-    SetUpCompressor(&state->compressor, compression_type, compression_level, nullptr);
+    SetUpCompressor(&state->compressor, compression_type, compression_level, dictionary, nullptr);
     return ConversionResultCode::Success;
   };
 
@@ -1823,10 +2199,40 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
     const bool compression = compression_type != WIARVZCompressionType::None;
 
-    return ProcessAndCompress(state, std::move(parameters), partition_entries, data_entries,
-                              file_system, &reusable_groups, &reusable_groups_mutex,
-                              chunks_per_wii_group, exception_lists_per_chunk,
-                              compressed_exception_lists, compression);
+    std::optional<Common::SHA1::Digest> chunk_store_key;
+    if (chunk_store)
+    {
+      std::optional<Common::SHA1::Digest> file_system_hash;
+      if (const auto it = file_system_hashes.find(file_system); it != file_system_hashes.end())
+        file_system_hash = it->second;
+
+      chunk_store_key =
+          GetChunkStoreKey(parameters, partition_entries, compression_type, compression_level,
+                           chunk_size, dictionary_hash, file_system_hash);
+
+      if (const std::optional<std::vector<u8>> stored = chunk_store->Load(*chunk_store_key))
+      {
+        std::optional<std::vector<OutputParametersEntry>> entries = DeserializeFromChunkStore(
+            *stored, GetNumberOfOutputEntries(parameters, chunks_per_wii_group,
+                                              exception_lists_per_chunk));
+        if (entries)
+        {
+          return ConversionResult<OutputParameters>(
+              OutputParameters{std::move(*entries), parameters.bytes_read, parameters.group_index});
+        }
+      }
+    }
+
+    ConversionResult<OutputParameters> result =
+        ProcessAndCompress(state, std::move(parameters), partition_entries, data_entries,
+                           file_system, &reusable_groups, &reusable_groups_mutex,
+                           chunks_per_wii_group, exception_lists_per_chunk,
+                           compressed_exception_lists, compression);
+
+    if (chunk_store_key && result && CanBeStoredInChunkStore(result->entries))
+      chunk_store->Store(*chunk_store_key, SerializeForChunkStore(result->entries));
+
+    return result;
   };
 
   const auto output = [&](OutputParameters parameters) {
@@ -1940,7 +2346,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
     return status;
 
   std::unique_ptr<Compressor> compressor;
-  SetUpCompressor(&compressor, compression_type, compression_level, &header_2);
+  SetUpCompressor(&compressor, compression_type, compression_level, dictionary, &header_2);
 
   const std::optional<std::vector<u8>> compressed_raw_data_entries = Compress(
       compressor.get(), reinterpret_cast<u8*>(raw_data_entries.data()), raw_data_entries_size);
@@ -1952,8 +2358,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   if (!compressed_group_entries)
     return ConversionResultCode::InternalError;
 
-  bytes_written = sizeof(WIAHeader1) + sizeof(WIAHeader2);
-  if (!outfile->Seek(sizeof(WIAHeader1) + sizeof(WIAHeader2), File::SeekOrigin::Begin))
+  bytes_written = sizeof(WIAHeader1) + sizeof(WIAHeader2) + dictionary.size();
+  if (!outfile->Seek(bytes_written, File::SeekOrigin::Begin))
     return ConversionResultCode::WriteFailed;
 
   u64 partition_entries_offset;
@@ -2010,11 +2416,18 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   header_1.magic = RVZ ? RVZ_MAGIC : WIA_MAGIC;
   header_1.version = Common::swap32(RVZ ? RVZ_VERSION : WIA_VERSION);
-  header_1.version_compatible =
-      Common::swap32(RVZ ? RVZ_VERSION_WRITE_COMPATIBLE : WIA_VERSION_WRITE_COMPATIBLE);
-  header_1.header_2_size = Common::swap32(sizeof(WIAHeader2));
-  header_1.header_2_hash =
-      Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_2), sizeof(header_2));
+  if (!dictionary.empty())
+    header_1.version_compatible = Common::swap32(RVZ_VERSION_WRITE_COMPATIBLE_ZSTD_DICTIONARY);
+  else if (RVZ)
+    header_1.version_compatible = Common::swap32(RVZ_VERSION_WRITE_COMPATIBLE);
+  else
+    header_1.version_compatible = Common::swap32(WIA_VERSION_WRITE_COMPATIBLE);
+  header_1.header_2_size = Common::swap32(static_cast<u32>(sizeof(WIAHeader2) + dictionary.size()));
+
+  const auto header_2_hash_context = Common::SHA1::CreateContext();
+  header_2_hash_context->Update(reinterpret_cast<const u8*>(&header_2), sizeof(header_2));
+  header_2_hash_context->Update(dictionary);
+  header_1.header_2_hash = header_2_hash_context->Finish();
   header_1.iso_file_size = Common::swap64(infile->GetDataSize());
   header_1.wia_file_size = Common::swap64(outfile->GetSize());
   header_1.header_1_hash = Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_1),
@@ -2027,6 +2440,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
     return ConversionResultCode::WriteFailed;
   if (!outfile->WriteArray(&header_2, 1))
     return ConversionResultCode::WriteFailed;
+  if (!dictionary.empty() && !outfile->WriteBytes(dictionary.data(), dictionary.size()))
+    return ConversionResultCode::WriteFailed;
 
   return ConversionResultCode::Success;
 }
@@ -2034,7 +2449,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback)
+                       int chunk_size, CompressCB callback, ChunkStore* chunk_store,
+                       bool zstd_dictionary)
 {
   File::IOFile outfile(outfile_path, "wb");
   if (!outfile)
@@ -2052,7 +2468,7 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
   const auto convert = rvz ? RVZFileReader::Convert : WIAFileReader::Convert;
   const ConversionResultCode result =
       convert(infile, infile_volume.get(), &outfile, compression_type, compression_level,
-              chunk_size, callback);
+              chunk_size, callback, chunk_store, zstd_dictionary);
 
   if (result == ConversionResultCode::ReadFailed)
     PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
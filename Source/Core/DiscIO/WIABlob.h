@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -16,12 +17,14 @@
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/ChunkPrefetcher.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
 #include "DiscIO/WiiEncryptionCache.h"
 
 namespace DiscIO
 {
+class ChunkStore;
 class FileSystem;
 class VolumeDisc;
 
@@ -69,7 +72,9 @@ public:
 
   static ConversionResultCode Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
-                                      int compression_level, int chunk_size, CompressCB callback);
+                                      int compression_level, int chunk_size, CompressCB callback,
+                                      ChunkStore* chunk_store = nullptr,
+                                      bool zstd_dictionary = false);
 
 private:
   using WiiKey = std::array<u8, 16>;
@@ -188,12 +193,15 @@ private:
   {
   public:
     Chunk();
-    Chunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
+    Chunk(const File::IOFile* file, u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
           u32 exception_lists, bool compressed_exception_lists, u32 rvz_packed_size,
           u64 data_offset, std::unique_ptr<Decompressor> decompressor);
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Decompresses the whole chunk. Afterwards, the chunk no longer accesses its file.
+    bool DecompressAll();
+
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
                            u64 exception_list_index, u16 additional_offset) const;
@@ -205,6 +213,7 @@ private:
     }
 
   private:
+    bool DecompressUpTo(u64 end_offset);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -216,7 +225,7 @@ private:
     size_t m_in_bytes_read = 0;
 
     std::unique_ptr<Decompressor> m_decompressor = nullptr;
-    File::IOFile* m_file = nullptr;
+    const File::IOFile* m_file = nullptr;
     u64 m_offset_in_file = 0;
 
     size_t m_out_bytes_allocated_for_exceptions = 0;
@@ -234,12 +243,28 @@ private:
 
   const PartitionEntry* GetPartition(u64 partition_data_offset, u32* partition_first_sector) const;
 
+  // The parameters that ReadFromGroups was called with, used for prefetching the following groups
+  struct GroupRange
+  {
+    u64 chunk_size;
+    u64 data_offset;
+    u64 data_size;
+    u32 group_index;
+    u32 number_of_groups;
+    u32 exception_lists;
+  };
+
   bool ReadFromGroups(u64* offset, u64* size, u8** out_ptr, u64 chunk_size, u32 sector_size,
                       u64 data_offset, u64 data_size, u32 group_index, u32 number_of_groups,
                       u32 exception_lists);
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk CreateChunk(const File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                    u64 decompressed_size, WIARVZCompressionType compression_type,
+                    u32 exception_lists, u32 rvz_packed_size, u64 data_offset) const;
+  std::optional<Chunk> PrefetchGroup(const File::IOFile* file, u64 total_group_index,
+                                     const GroupRange& range) const;
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -341,9 +366,11 @@ private:
   static bool WriteHeader(File::IOFile* file, const u8* data, size_t size, u64 upper_bound,
                           u64* bytes_written, u64* offset_out);
 
+  static std::vector<u8> CreateZstdDictionary(BlobReader* infile,
+                                              const std::vector<PartitionEntry>& partition_entries);
   static void SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                               WIARVZCompressionType compression_type, int compression_level,
-                              WIAHeader2* header_2);
+                              const std::vector<u8>& zstd_dictionary, WIAHeader2* header_2);
   static bool TryReuse(std::map<ReuseID, GroupEntry>* reusable_groups,
                        std::mutex* reusable_groups_mutex, OutputParametersEntry* entry);
   static ConversionResult<OutputParameters>
@@ -354,6 +381,18 @@ private:
                      std::mutex* reusable_groups_mutex, u64 chunks_per_wii_group,
                      u64 exception_lists_per_chunk, bool compressed_exception_lists,
                      bool compression);
+  static Common::SHA1::Digest
+  GetChunkStoreKey(const CompressParameters& parameters,
+                   const std::vector<PartitionEntry>& partition_entries,
+                   WIARVZCompressionType compression_type, int compression_level, int chunk_size,
+                   const std::optional<Common::SHA1::Digest>& zstd_dictionary_hash,
+                   const std::optional<Common::SHA1::Digest>& file_system_hash);
+  static bool CanBeStoredInChunkStore(const std::vector<OutputParametersEntry>& entries);
+  static std::vector<u8> SerializeForChunkStore(const std::vector<OutputParametersEntry>& entries);
+  static size_t GetNumberOfOutputEntries(const CompressParameters& parameters,
+                                         u64 chunks_per_wii_group, u64 exception_lists_per_chunk);
+  static std::optional<std::vector<OutputParametersEntry>>
+  DeserializeFromChunkStore(const std::vector<u8>& data, size_t expected_entries);
   static ConversionResultCode Output(std::vector<OutputParametersEntry>* entries,
                                      File::IOFile* outfile,
                                      std::map<ReuseID, GroupEntry>* reusable_groups,
@@ -383,6 +422,12 @@ private:
 
   std::map<u64, DataEntry> m_data_entries;
 
+  // Only used by RVZ files compressed with Zstandard that were converted with a dictionary
+  std::unique_ptr<ZstdDecompressionDictionary> m_zstd_dictionary;
+
+  // Declared last so that its worker threads are stopped before anything they use is destroyed
+  std::unique_ptr<ChunkPrefetcher<Chunk, GroupRange>> m_prefetcher;
+
   // Perhaps we could set WIA_VERSION_WRITE_COMPATIBLE to 0.9, but WIA version 0.9 was never in
   // any official release of wit, and interim versions (either source or binaries) are hard to find.
   // Since we've been unable to check if we're write compatible with 0.9, we set it 1.0 to be safe.
@@ -391,9 +436,13 @@ private:
   static constexpr u32 WIA_VERSION_WRITE_COMPATIBLE = 0x01000000;
   static constexpr u32 WIA_VERSION_READ_COMPATIBLE = 0x00080000;
 
-  static constexpr u32 RVZ_VERSION = 0x01000000;
+  static constexpr u32 RVZ_VERSION = 0x01010000;
   static constexpr u32 RVZ_VERSION_WRITE_COMPATIBLE = 0x00030000;
   static constexpr u32 RVZ_VERSION_READ_COMPATIBLE = 0x00030000;
+
+  // Files with a Zstandard dictionary can't be read by anything that predates dictionaries
+  static constexpr u32 RVZ_VERSION_WRITE_COMPATIBLE_ZSTD_DICTIONARY = 0x01010000;
+  static constexpr u32 MAX_ZSTD_DICTIONARY_SIZE = 0x1C000;
 };
 
 using WIAFileReader = WIARVZFileReader<false>;
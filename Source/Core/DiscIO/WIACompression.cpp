@@ -4,11 +4,14 @@
 #include "DiscIO/WIACompression.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstring>
 #include <limits>
 #include <memory>
 #include <optional>
+#include <queue>
+#include <utility>
 #include <vector>
 
 #include <bzlib.h>
@@ -256,9 +259,131 @@ bool LZMADecompressor::Decompress(const DecompressionBuffer& in, DecompressionBu
   return result == LZMA_OK || result == LZMA_STREAM_END;
 }
 
-ZstdDecompressor::ZstdDecompressor()
+std::vector<u8> BuildZstdDictionary(const std::vector<std::vector<u8>>& samples, size_t max_size)
+{
+  // This is a simplified version of the cover algorithm that zstd's own dictionary builder uses.
+  // Each segment is scored by how many other segments share its 8-byte substrings, and the best
+  // segments are picked greedily, discounting substrings that already are in the dictionary.
+  constexpr size_t SEGMENT_SIZE = 0x400;
+  constexpr size_t SUBSTRING_SIZE = 8;
+  constexpr u32 HASH_BITS = 20;
+
+  struct Segment
+  {
+    const u8* data;
+    size_t size;
+  };
+
+  std::vector<Segment> segments;
+  for (const std::vector<u8>& sample : samples)
+  {
+    for (size_t i = 0; i + SEGMENT_SIZE <= sample.size(); i += SEGMENT_SIZE)
+      segments.push_back(Segment{sample.data() + i, SEGMENT_SIZE});
+  }
+
+  std::vector<u32> hashes;
+  const auto get_hashes = [&hashes](const Segment& segment) {
+    hashes.clear();
+    for (size_t i = 0; i + SUBSTRING_SIZE <= segment.size; ++i)
+    {
+      u64 substring;
+      std::memcpy(&substring, segment.data + i, sizeof(substring));
+      hashes.push_back(static_cast<u32>((substring * 0x9E3779B97F4A7C15) >> (64 - HASH_BITS)));
+    }
+
+    // A substring that occurs many times in one segment (like zeroes) only counts once
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+  };
+
+  // The number of segments each substring occurs in
+  std::vector<u32> frequencies(1 << HASH_BITS);
+  for (const Segment& segment : segments)
+  {
+    get_hashes(segment);
+    for (u32 hash : hashes)
+      ++frequencies[hash];
+  }
+
+  const auto score = [&](const Segment& segment) {
+    get_hashes(segment);
+    u64 result = 0;
+    for (u32 hash : hashes)
+    {
+      // Substrings that occur in only this segment are of no use in a dictionary
+      if (frequencies[hash] > 1)
+        result += frequencies[hash];
+    }
+    return result;
+  };
+
+  std::priority_queue<std::pair<u64, size_t>> queue;
+  for (size_t i = 0; i < segments.size(); ++i)
+    queue.emplace(score(segments[i]), i);
+
+  std::vector<size_t> picked_segments;
+  size_t dictionary_size = 0;
+  while (!queue.empty() && dictionary_size + SEGMENT_SIZE <= max_size)
+  {
+    const size_t index = queue.top().second;
+    queue.pop();
+
+    // Scores only ever go down as segments are picked, so the score in the queue is an upper bound
+    // of the real score. If the real score still beats the next best upper bound, the segment wins.
+    const u64 current_score = score(segments[index]);
+    if (current_score == 0)
+      continue;
+    if (!queue.empty() && current_score < queue.top().first)
+    {
+      queue.emplace(current_score, index);
+      continue;
+    }
+
+    for (u32 hash : hashes)
+      frequencies[hash] = 0;
+
+    picked_segments.push_back(index);
+    dictionary_size += segments[index].size;
+  }
+
+  // zstd finds matches at the end of the dictionary using the smallest offsets, so put the best
+  // segments last
+  std::vector<u8> dictionary;
+  dictionary.reserve(dictionary_size);
+  for (auto it = picked_segments.rbegin(); it != picked_segments.rend(); ++it)
+    dictionary.insert(dictionary.end(), segments[*it].data, segments[*it].data + SEGMENT_SIZE);
+
+  // Make sure that zstd won't try to parse this as a structured dictionary
+  static constexpr std::array<u8, 4> DICTIONARY_MAGIC = {0x37, 0xA4, 0x30, 0xEC};
+  if (dictionary.size() >= DICTIONARY_MAGIC.size() &&
+      std::equal(DICTIONARY_MAGIC.begin(), DICTIONARY_MAGIC.end(), dictionary.begin()))
+  {
+    dictionary[0] = 0;
+  }
+
+  return dictionary;
+}
+
+ZstdDecompressionDictionary::ZstdDecompressionDictionary(const std::vector<u8>& dictionary)
+{
+  m_dictionary = ZSTD_createDDict(dictionary.data(), dictionary.size());
+}
+
+ZstdDecompressionDictionary::~ZstdDecompressionDictionary()
+{
+  ZSTD_freeDDict(m_dictionary);
+}
+
+ZstdDecompressor::ZstdDecompressor(const ZstdDecompressionDictionary* dictionary)
 {
   m_stream = ZSTD_createDStream();
+
+  if (m_stream && dictionary &&
+      (!dictionary->Get() || ZSTD_isError(ZSTD_DCtx_refDDict(m_stream, dictionary->Get()))))
+  {
+    ZSTD_freeDStream(m_stream);
+    m_stream = nullptr;
+  }
 }
 
 ZstdDecompressor::~ZstdDecompressor()
@@ -733,12 +858,14 @@ size_t LZMACompressor::GetSize() const
   return static_cast<size_t>(m_stream.next_out - m_buffer.data());
 }
 
-ZstdCompressor::ZstdCompressor(int compression_level)
+ZstdCompressor::ZstdCompressor(int compression_level, const std::vector<u8>& dictionary)
 {
   m_stream = ZSTD_createCStream();
 
   if (ZSTD_isError(ZSTD_CCtx_setParameter(m_stream, ZSTD_c_compressionLevel, compression_level)) ||
-      ZSTD_isError(ZSTD_CCtx_setParameter(m_stream, ZSTD_c_contentSizeFlag, 0)))
+      ZSTD_isError(ZSTD_CCtx_setParameter(m_stream, ZSTD_c_contentSizeFlag, 0)) ||
+      (!dictionary.empty() &&
+       ZSTD_isError(ZSTD_CCtx_loadDictionary(m_stream, dictionary.data(), dictionary.size()))))
   {
     m_stream = nullptr;
   }
@@ -102,10 +102,31 @@ private:
   bool m_error_occurred = false;
 };
 
+// Builds a raw content dictionary for Zstandard out of the segments of the samples that have the
+// most in common with the other samples. Returns an empty vector if no useful dictionary was found.
+std::vector<u8> BuildZstdDictionary(const std::vector<std::vector<u8>>& samples, size_t max_size);
+
+// A Zstandard dictionary that has been prepared for decompression once, so that it can be shared
+// between the decompressors of all chunks (including on other threads)
+class ZstdDecompressionDictionary final
+{
+public:
+  explicit ZstdDecompressionDictionary(const std::vector<u8>& dictionary);
+  ~ZstdDecompressionDictionary();
+
+  ZstdDecompressionDictionary(const ZstdDecompressionDictionary&) = delete;
+  ZstdDecompressionDictionary& operator=(const ZstdDecompressionDictionary&) = delete;
+
+  const ZSTD_DDict* Get() const { return m_dictionary; }
+
+private:
+  ZSTD_DDict* m_dictionary;
+};
+
 class ZstdDecompressor final : public Decompressor
 {
 public:
-  ZstdDecompressor();
+  explicit ZstdDecompressor(const ZstdDecompressionDictionary* dictionary = nullptr);
   ~ZstdDecompressor();
 
   bool Decompress(const DecompressionBuffer& in, DecompressionBuffer* out,
@@ -228,7 +249,8 @@ private:
 class ZstdCompressor final : public Compressor
 {
 public:
-  ZstdCompressor(int compression_level);
+  // An empty dictionary means that no dictionary is used
+  ZstdCompressor(int compression_level, const std::vector<u8>& dictionary = {});
   ~ZstdCompressor();
 
   bool Start(std::optional<u64> size) override;
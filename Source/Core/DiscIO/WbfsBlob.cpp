@@ -37,9 +37,8 @@ WbfsFileReader::WbfsFileReader(File::IOFile file, const std::string& path)
 
   // Grab disc info (assume slot 0, checked in ReadHeader())
   m_wlba_table.resize(m_blocks_per_disc);
-  m_files[0].file.Seek(m_hd_sector_size + WII_DISC_HEADER_SIZE /*+ i * m_disc_info_size*/,
-                       File::SeekOrigin::Begin);
-  m_files[0].file.ReadBytes(m_wlba_table.data(), m_blocks_per_disc * sizeof(u16));
+  m_files[0].file.ReadAt(m_wlba_table.data(), m_blocks_per_disc * sizeof(u16),
+                         m_hd_sector_size + WII_DISC_HEADER_SIZE /*+ i * m_disc_info_size*/);
   for (size_t i = 0; i < m_blocks_per_disc; i++)
     m_wlba_table[i] = Common::swap16(m_wlba_table[i]);
 }
@@ -96,8 +95,7 @@ bool WbfsFileReader::AddFileToList(File::IOFile file)
 bool WbfsFileReader::ReadHeader()
 {
   // Read hd size info
-  m_files[0].file.Seek(0, File::SeekOrigin::Begin);
-  m_files[0].file.ReadBytes(&m_header, sizeof(WbfsHeader));
+  m_files[0].file.ReadAt(&m_header, sizeof(WbfsHeader), 0);
   if (m_header.magic != WBFS_MAGIC)
     return false;
 
@@ -130,16 +128,14 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   while (nbytes)
   {
     u64 read_size;
-    File::IOFile& data_file = SeekToCluster(offset, &read_size);
+    u64 offset_in_file;
+    const File::IOFile& data_file = FindCluster(offset, &read_size, &offset_in_file);
     if (read_size == 0)
       return false;
     read_size = std::min(read_size, nbytes);
 
-    if (!data_file.ReadBytes(out_ptr, read_size))
-    {
-      data_file.ClearError();
+    if (!data_file.ReadAt(out_ptr, read_size, offset_in_file))
       return false;
-    }
 
     out_ptr += read_size;
     nbytes -= read_size;
@@ -149,7 +145,8 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   return true;
 }
 
-File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
+const File::IOFile& WbfsFileReader::FindCluster(u64 offset, u64* available,
+                                                u64* offset_in_file) const
 {
   u64 base_cluster = (offset >> m_header.wbfs_sector_shift);
   if (base_cluster < m_blocks_per_disc)
@@ -158,11 +155,11 @@ File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
     u64 cluster_offset = offset & (m_wbfs_sector_size - 1);
     u64 final_address = cluster_address + cluster_offset;
 
-    for (FileEntry& file_entry : m_files)
+    for (const FileEntry& file_entry : m_files)
     {
       if (final_address < (file_entry.base_address + file_entry.size))
       {
-        file_entry.file.Seek(final_address - file_entry.base_address, File::SeekOrigin::Begin);
+        *offset_in_file = final_address - file_entry.base_address;
         if (available)
         {
           u64 till_end_of_file = file_entry.size - (final_address - file_entry.base_address);
@@ -178,7 +175,7 @@ File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
   ERROR_LOG_FMT(DISCIO, "Read beyond end of disc");
   if (available)
     *available = 0;
-  m_files[0].file.Seek(0, File::SeekOrigin::Begin);
+  *offset_in_file = 0;
   return m_files[0].file;
 }
 
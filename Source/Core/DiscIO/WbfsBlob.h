@@ -43,7 +43,8 @@ private:
   bool AddFileToList(File::IOFile file);
   bool ReadHeader();
 
-  File::IOFile& SeekToCluster(u64 offset, u64* available);
+  // Returns the file that contains the given offset, and where in that file it is
+  const File::IOFile& FindCluster(u64 offset, u64* available, u64* offset_in_file) const;
   bool IsGood() { return m_good; }
   struct FileEntry
   {
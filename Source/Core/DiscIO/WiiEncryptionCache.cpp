@@ -3,66 +3,151 @@
 
 #include "DiscIO/WiiEncryptionCache.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
-#include <limits>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "Common/Align.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/Timer.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/VolumeWii.h"
 
 namespace DiscIO
 {
-WiiEncryptionCache::WiiEncryptionCache(BlobReader* blob) : m_blob(blob)
+// 16 MiB. Games which read encrypted data randomly tend to go back and forth between a handful of
+// files, and every miss costs hashing and encrypting 2 MiB.
+constexpr size_t CACHED_GROUP_COUNT = 8;
+
+struct WiiEncryptionCache::SharedGroups
+{
+  ~SharedGroups()
+  {
+    if (stats.groups_encrypted == 0)
+      return;
+
+    const double seconds = (Common::Timer::NowUs() - created_us) / 1000000.0;
+    INFO_LOG_FMT(DISCIO,
+                 "Encryption cache: {} hits, {} groups encrypted ({:.2f} per second) taking {} ms",
+                 stats.hits, stats.groups_encrypted, stats.groups_encrypted / seconds,
+                 stats.encryption_time_us / 1000);
+  }
+
+  std::mutex mutex;
+  // Pairs of offsets and groups, ordered from most recently used to least recently used
+  std::vector<std::pair<u64, std::shared_ptr<Group>>> groups;
+  // An evicted group that nobody is using anymore, kept around to avoid reallocating it
+  std::shared_ptr<Group> spare_group;
+  Stats stats;
+  u64 created_us = Common::Timer::NowUs();
+};
+
+WiiEncryptionCache::WiiEncryptionCache(BlobReader* blob)
+    : m_blob(blob), m_shared_groups(std::make_shared<SharedGroups>())
+{
+}
+
+WiiEncryptionCache::WiiEncryptionCache(BlobReader* blob,
+                                       const WiiEncryptionCache& share_groups_with)
+    : m_blob(blob), m_shared_groups(share_groups_with.m_shared_groups)
 {
 }
 
 WiiEncryptionCache::~WiiEncryptionCache() = default;
 
+WiiEncryptionCache::Stats WiiEncryptionCache::GetStats() const
+{
+  std::lock_guard lk(m_shared_groups->mutex);
+  return m_shared_groups->stats;
+}
+
 const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>*
 WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
                                  u64 partition_data_decrypted_size, const Key& key,
                                  const HashExceptionCallback& hash_exception_callback)
 {
-  // Only allocate memory if this function actually ends up getting called
-  if (!m_cache)
-  {
-    m_cache = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
-    m_cached_offset = std::numeric_limits<u64>::max();
-  }
-
   ASSERT(offset % VolumeWii::GROUP_TOTAL_SIZE == 0);
   const u64 group_offset_in_partition =
       offset / VolumeWii::GROUP_TOTAL_SIZE * VolumeWii::GROUP_DATA_SIZE;
   const u64 group_offset_on_disc = partition_data_offset + offset;
 
-  if (m_cached_offset != group_offset_on_disc)
+  SharedGroups& shared = *m_shared_groups;
+  std::shared_ptr<Group> group;
+
   {
-    std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
+    std::lock_guard lk(shared.mutex);
 
-    if (hash_exception_callback)
+    auto it = std::find_if(shared.groups.begin(), shared.groups.end(),
+                           [&](const auto& entry) { return entry.first == group_offset_on_disc; });
+    if (it != shared.groups.end())
     {
-      hash_exception_callback_2 =
-          [offset, &hash_exception_callback](
-              VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
-            return hash_exception_callback(hash_blocks, offset);
-          };
+      std::rotate(shared.groups.begin(), it, it + 1);
+      ++shared.stats.hits;
+      m_last_group = shared.groups.front().second;
+      return m_last_group.get();
     }
 
-    if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
-                                 partition_data_decrypted_size, key, m_blob, m_cache.get(),
-                                 hash_exception_callback_2))
+    // Only allocate memory if this function actually ends up getting called
+    group = std::move(shared.spare_group);
+  }
+
+  // The lock isn't held while encrypting, so that other readers sharing the groups can use the
+  // cache in the meantime. In the rare case that two readers miss on the same group at once, both
+  // of them encrypt it.
+  if (!group)
+    group = std::make_shared<Group>();
+
+  std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
+
+  if (hash_exception_callback)
+  {
+    hash_exception_callback_2 =
+        [offset, &hash_exception_callback](
+            VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
+          return hash_exception_callback(hash_blocks, offset);
+        };
+  }
+
+  const u64 start_us = Common::Timer::NowUs();
+
+  if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
+                               partition_data_decrypted_size, key, m_blob, group.get(),
+                               hash_exception_callback_2))
+  {
+    return nullptr;
+  }
+
+  const u64 encryption_time_us = Common::Timer::NowUs() - start_us;
+
+  {
+    std::lock_guard lk(shared.mutex);
+
+    ++shared.stats.groups_encrypted;
+    shared.stats.encryption_time_us += encryption_time_us;
+
+    const bool already_cached =
+        std::any_of(shared.groups.begin(), shared.groups.end(),
+                    [&](const auto& entry) { return entry.first == group_offset_on_disc; });
+    if (!already_cached)
+      shared.groups.emplace(shared.groups.begin(), group_offset_on_disc, group);
+
+    if (shared.groups.size() > CACHED_GROUP_COUNT)
     {
-      m_cached_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
-      return nullptr;
+      // Groups which are still in use by some reader can't be reused
+      std::shared_ptr<Group> evicted = std::move(shared.groups.back().second);
+      shared.groups.pop_back();
+      if (evicted.use_count() == 1)
+        shared.spare_group = std::move(evicted);
     }
-
-    m_cached_offset = group_offset_on_disc;
   }
 
-  return m_cache.get();
+  m_last_group = std::move(group);
+  return m_last_group.get();
 }
 
 bool WiiEncryptionCache::EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset,
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <limits>
 #include <memory>
 
@@ -14,6 +15,8 @@ namespace DiscIO
 {
 class BlobReader;
 
+// Keeps the most recently used groups of re-encrypted data around, so that reads which jump back
+// and forth between a few groups don't have to hash and encrypt a whole group every time.
 class WiiEncryptionCache
 {
 public:
@@ -21,8 +24,22 @@ public:
   using HashExceptionCallback = std::function<void(
       VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP], u64 offset)>;
 
+  struct Stats
+  {
+    // Groups that were found in the cache
+    u64 hits = 0;
+    // Groups that had to be hashed and encrypted
+    u64 groups_encrypted = 0;
+    // Time spent hashing and encrypting, in microseconds
+    u64 encryption_time_us = 0;
+  };
+
   // The blob pointer is kept around for the lifetime of this object.
   explicit WiiEncryptionCache(BlobReader* blob);
+  // Shares the cached groups with another cache, which must be for the same disc (for instance
+  // the cache of the reader that the blob was copied from). Can be used from several threads at
+  // once, as long as each thread uses a WiiEncryptionCache object of its own.
+  WiiEncryptionCache(BlobReader* blob, const WiiEncryptionCache& share_groups_with);
   ~WiiEncryptionCache();
 
   WiiEncryptionCache(WiiEncryptionCache&&) = default;
@@ -37,6 +54,7 @@ public:
   // If the returned pointer is nullptr, reading from the blob failed.
   // If the returned pointer is not nullptr, it is guaranteed to be valid until
   // the next call of this function or the destruction of this object.
+  // Only the group which was used the longest ago is evicted when a new group is cached.
   const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>*
   EncryptGroup(u64 offset, u64 partition_data_offset, u64 partition_data_decrypted_size,
                const Key& key, const HashExceptionCallback& hash_exception_callback = {});
@@ -47,10 +65,16 @@ public:
                      u64 partition_data_decrypted_size, const Key& key,
                      const HashExceptionCallback& hash_exception_callback = {});
 
+  Stats GetStats() const;
+
 private:
+  using Group = std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>;
+  struct SharedGroups;
+
   BlobReader* m_blob;
-  std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> m_cache;
-  u64 m_cached_offset = 0;
+  std::shared_ptr<SharedGroups> m_shared_groups;
+  // The group most recently returned by EncryptGroup, kept alive even if it gets evicted
+  std::shared_ptr<Group> m_last_group;
 };
 
 }  // namespace DiscIO
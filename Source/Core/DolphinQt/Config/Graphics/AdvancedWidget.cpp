@@ -164,6 +164,10 @@ void AdvancedWidget::CreateWidgets()
       // i18n: VS is short for vertex shaders.
       tr("Prefer VS for Point/Line Expansion"), Config::GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION);
   m_cpu_cull = new ConfigBool(tr("Cull Vertices on the CPU"), Config::GFX_CPU_CULL);
+  m_prefer_mailbox_present =
+      new ConfigBool(tr("Prefer Mailbox Presentation"), Config::GFX_PREFER_MAILBOX_PRESENT);
+  m_present_queue_depth =
+      new ConfigInteger(1, MAX_PRESENT_QUEUE_DEPTH, Config::GFX_PRESENT_QUEUE_DEPTH);
 
   misc_layout->addWidget(m_enable_cropping, 0, 0);
   misc_layout->addWidget(m_enable_prog_scan, 0, 1);
@@ -176,6 +180,10 @@ void AdvancedWidget::CreateWidgets()
 
   misc_layout->addWidget(m_borderless_fullscreen, 2, 1);
 #endif
+  misc_layout->addWidget(m_prefer_mailbox_present, 3, 0);
+  misc_layout->addWidget(new QLabel(tr("Present Queue Depth:")), 4, 0);
+  m_present_queue_depth->SetTitle(tr("Present Queue Depth"));
+  misc_layout->addWidget(m_present_queue_depth, 4, 1);
 
   // Experimental.
   auto* experimental_box = new QGroupBox(tr("Experimental"));
@@ -186,9 +194,12 @@ void AdvancedWidget::CreateWidgets()
       new ConfigBool(tr("Defer EFB Cache Invalidation"), Config::GFX_HACK_EFB_DEFER_INVALIDATION);
   m_manual_texture_sampling =
       new ConfigBool(tr("Manual Texture Sampling"), Config::GFX_HACK_FAST_TEXTURE_SAMPLING, true);
+  m_async_efb_peeks =
+      new ConfigBool(tr("Asynchronous EFB Cache Reads"), Config::GFX_HACK_EFB_ASYNC_PEEKS);
 
   experimental_layout->addWidget(m_defer_efb_access_invalidation, 0, 0);
   experimental_layout->addWidget(m_manual_texture_sampling, 0, 1);
+  experimental_layout->addWidget(m_async_efb_peeks, 1, 0);
 
   main_layout->addWidget(performance_box);
   main_layout->addWidget(debugging_box);
@@ -237,6 +248,7 @@ void AdvancedWidget::SaveSettings()
 void AdvancedWidget::OnBackendChanged()
 {
   m_backend_multithreading->setEnabled(g_Config.backend_info.bSupportsMultithreading);
+  m_present_queue_depth->setEnabled(g_Config.backend_info.bSupportsMultithreading);
   m_prefer_vs_for_point_line_expansion->setEnabled(
       g_Config.backend_info.bSupportsGeometryShaders &&
       g_Config.backend_info.bSupportsVSLinePointExpand);
@@ -376,6 +388,17 @@ void AdvancedWidget::AddDescriptions()
                  "for expanding points and lines, selects the vertex shader for the job.  May "
                  "affect performance."
                  "<br><br>%1");
+  static const char TR_PREFER_MAILBOX_PRESENT_DESCRIPTION[] =
+      QT_TR_NOOP("When V-Sync is enabled, presents frames in mailbox mode instead of waiting for "
+                 "each vertical blank. This avoids tearing with lower input latency, but frames "
+                 "may be dropped. Currently, this is limited to the Vulkan backend.<br><br>"
+                 "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
+  static const char TR_PRESENT_QUEUE_DEPTH_DESCRIPTION[] =
+      QT_TR_NOOP("Sets how many frames can be waiting to be presented before emulation waits for "
+                 "the display. Higher values reduce stuttering caused by slow presentation, at "
+                 "the cost of an additional frame of latency each. Requires Backend "
+                 "Multithreading, and is currently limited to the Vulkan backend.<br><br>"
+                 "<dolphin_emphasis>If unsure, set this to 1.</dolphin_emphasis>");
   static const char TR_CPU_CULL_DESCRIPTION[] =
       QT_TR_NOOP("Cull vertices on the CPU to reduce the number of draw calls required.  "
                  "May affect performance and draw statistics.<br><br>"
@@ -386,6 +409,13 @@ void AdvancedWidget::AddDescriptions()
       "<br><br>May improve performance in some games which rely on CPU EFB Access at the cost "
       "of stability.<br><br><dolphin_emphasis>If unsure, leave this "
       "unchecked.</dolphin_emphasis>");
+  static const char TR_ASYNC_EFB_PEEKS_DESCRIPTION[] = QT_TR_NOOP(
+      "When a CPU EFB read hits a region of the EFB access cache that has been invalidated, "
+      "returns the previously read value and refreshes the region in the background instead of "
+      "waiting for the GPU. Results may be up to one synchronization point out of date."
+      "<br><br>Greatly improves performance in games which read the EFB every frame, but may "
+      "cause visual glitches in games which need exact results.<br><br><dolphin_emphasis>If "
+      "unsure, leave this unchecked.</dolphin_emphasis>");
   static const char TR_MANUAL_TEXTURE_SAMPLING_DESCRIPTION[] = QT_TR_NOOP(
       "Use a manual implementation of texture sampling instead of the graphics backend's built-in "
       "functionality.<br><br>"
@@ -453,9 +483,12 @@ void AdvancedWidget::AddDescriptions()
   m_prefer_vs_for_point_line_expansion->SetDescription(
       tr(TR_PREFER_VS_FOR_POINT_LINE_EXPANSION_DESCRIPTION).arg(vsexpand_extra));
   m_cpu_cull->SetDescription(tr(TR_CPU_CULL_DESCRIPTION));
+  m_prefer_mailbox_present->SetDescription(tr(TR_PREFER_MAILBOX_PRESENT_DESCRIPTION));
+  m_present_queue_depth->SetDescription(tr(TR_PRESENT_QUEUE_DEPTH_DESCRIPTION));
 #ifdef _WIN32
   m_borderless_fullscreen->SetDescription(tr(TR_BORDERLESS_FULLSCREEN_DESCRIPTION));
 #endif
   m_defer_efb_access_invalidation->SetDescription(tr(TR_DEFER_EFB_ACCESS_INVALIDATION_DESCRIPTION));
+  m_async_efb_peeks->SetDescription(tr(TR_ASYNC_EFB_PEEKS_DESCRIPTION));
   m_manual_texture_sampling->SetDescription(tr(TR_MANUAL_TEXTURE_SAMPLING_DESCRIPTION));
 }
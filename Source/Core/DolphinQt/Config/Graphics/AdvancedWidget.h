@@ -70,9 +70,12 @@ private:
   ConfigBool* m_backend_multithreading;
   ConfigBool* m_prefer_vs_for_point_line_expansion;
   ConfigBool* m_cpu_cull;
+  ConfigBool* m_prefer_mailbox_present;
+  ConfigInteger* m_present_queue_depth;
   ConfigBool* m_borderless_fullscreen;
 
   // Experimental
   ConfigBool* m_defer_efb_access_invalidation;
+  ConfigBool* m_async_efb_peeks;
   ConfigBool* m_manual_texture_sampling;
 };
@@ -135,6 +135,9 @@ void GeneralWidget::CreateWidgets()
   m_wait_for_shaders = new ConfigBool(tr("Compile Shaders Before Starting"),
                                       Config::GFX_WAIT_FOR_SHADERS_BEFORE_STARTING);
   shader_compilation_layout->addWidget(m_wait_for_shaders);
+  m_partially_specialized_ubershaders = new ConfigBool(
+      tr("Partially Specialized Ubershaders"), Config::GFX_PARTIALLY_SPECIALIZED_UBERSHADERS);
+  shader_compilation_layout->addWidget(m_partially_specialized_ubershaders);
   shader_compilation_box->setLayout(shader_compilation_layout);
 
   main_layout->addWidget(m_video_box);
@@ -162,6 +165,8 @@ void GeneralWidget::ConnectWidgets()
     m_custom_aspect_width->setHidden(!is_custom_aspect_ratio);
     m_custom_aspect_height->setHidden(!is_custom_aspect_ratio);
   });
+  connect(m_shader_compilation_mode[2], &QRadioButton::toggled,
+          m_partially_specialized_ubershaders, &ConfigBool::setEnabled);
 }
 
 void GeneralWidget::LoadSettings()
@@ -176,6 +181,11 @@ void GeneralWidget::LoadSettings()
   m_custom_aspect_label->setHidden(!is_custom_aspect_ratio);
   m_custom_aspect_width->setHidden(!is_custom_aspect_ratio);
   m_custom_aspect_height->setHidden(!is_custom_aspect_ratio);
+
+  // Only hybrid ubershaders are partially specialized
+  m_partially_specialized_ubershaders->setEnabled(
+      Config::Get(Config::GFX_SHADER_COMPILATION_MODE) ==
+      ShaderCompilationMode::AsynchronousUberShaders);
 }
 
 void GeneralWidget::SaveSettings()
@@ -295,6 +305,13 @@ void GeneralWidget::AddDescriptions()
                  "two or fewer cores, it is recommended to enable this option, as a large shader "
                  "queue may reduce frame rates.<br><br><dolphin_emphasis>Otherwise, if "
                  "unsure, leave this unchecked.</dolphin_emphasis>");
+  static const char TR_PARTIALLY_SPECIALIZED_UBERSHADERS_DESCRIPTION[] = QT_TR_NOOP(
+      "While an object's specialized shader is being compiled, draws it with an ubershader "
+      "that is specialized for its number of TEV stages, fog and alpha test. These are faster "
+      "on the GPU than the regular ubershaders, but have to be compiled as well, so the "
+      "regular ubershaders are still used until they are ready.<br><br>Only used with Hybrid "
+      "Ubershaders.<br><br><dolphin_emphasis>If unsure, leave this "
+      "unchecked.</dolphin_emphasis>");
 
   m_backend_combo->SetTitle(tr("Backend"));
   m_backend_combo->SetDescription(tr(TR_BACKEND_DESCRIPTION));
@@ -328,6 +345,9 @@ void GeneralWidget::AddDescriptions()
   m_shader_compilation_mode[3]->SetDescription(tr(TR_SHADER_COMPILE_SKIP_DRAWING_DESCRIPTION));
 
   m_wait_for_shaders->SetDescription(tr(TR_SHADER_COMPILE_BEFORE_START_DESCRIPTION));
+
+  m_partially_specialized_ubershaders->SetDescription(
+      tr(TR_PARTIALLY_SPECIALIZED_UBERSHADERS_DESCRIPTION));
 }
 
 void GeneralWidget::OnBackendChanged(const QString& backend_name)
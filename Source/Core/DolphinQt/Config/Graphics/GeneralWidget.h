@@ -56,4 +56,5 @@ private:
   ConfigBool* m_render_main_window;
   std::array<ConfigRadioInt*, 4> m_shader_compilation_mode{};
   ConfigBool* m_wait_for_shaders;
+  ConfigBool* m_partially_specialized_ubershaders;
 };
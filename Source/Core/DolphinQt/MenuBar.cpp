@@ -44,6 +44,7 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/PowerPC/SignatureDB/SignatureDB.h"
 #include "Core/State.h"
 #include "Core/System.h"
@@ -158,6 +159,9 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_clear_cache->setEnabled(running);
   m_jit_log_coverage->setEnabled(!running);
   m_jit_search_instruction->setEnabled(running);
+  m_jit_sampling_profiler->setEnabled(running);
+  if (!running && m_jit_sampling_profiler->isChecked())
+    m_jit_sampling_profiler->setChecked(false);
 
   // Symbols
   m_symbols->setEnabled(running);
@@ -890,6 +894,10 @@ void MenuBar::AddJITMenu()
   m_jit_search_instruction =
       m_jit->addAction(tr("Search for an Instruction"), this, &MenuBar::SearchInstruction);
 
+  m_jit_sampling_profiler = m_jit->addAction(tr("Sample CPU Profile"));
+  m_jit_sampling_profiler->setCheckable(true);
+  connect(m_jit_sampling_profiler, &QAction::toggled, this, &MenuBar::ToggleSamplingProfiler);
+
   m_jit->addSeparator();
 
   m_jit_off = m_jit->addAction(tr("JIT Off (JIT Core)"));
@@ -1761,6 +1769,32 @@ void MenuBar::LogInstructions()
   PPCTables::LogCompiledInstructions();
 }
 
+void MenuBar::ToggleSamplingProfiler(bool enabled)
+{
+  auto& profiler = Core::System::GetInstance().GetJitInterface().GetSamplingProfiler();
+  if (enabled)
+  {
+    profiler.Start();
+    return;
+  }
+
+  profiler.Stop();
+
+  static unsigned int count = 0;
+  const std::string path =
+      File::GetUserPath(D_DUMP_IDX) + "ppc_profile_" + std::to_string(count++) + ".folded";
+  if (!profiler.WriteFoldedStacks(path))
+  {
+    ModalMessageBox::critical(this, tr("Failure"), tr("Failed to write the CPU profile."));
+    return;
+  }
+
+  ModalMessageBox::information(this, tr("Sample CPU Profile"),
+                               tr("Wrote %1 samples to %2")
+                                   .arg(profiler.GetSampleCount())
+                                   .arg(QString::fromStdString(path)));
+}
+
 void MenuBar::SearchInstruction()
 {
   bool good;
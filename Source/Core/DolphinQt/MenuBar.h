@@ -183,6 +183,7 @@ private:
   void ClearCache();
   void LogInstructions();
   void SearchInstruction();
+  void ToggleSamplingProfiler(bool enabled);
 
   void OnSelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
   void OnRecordingStatusChanged(bool recording);
@@ -271,6 +272,7 @@ private:
   QAction* m_jit_clear_cache;
   QAction* m_jit_log_coverage;
   QAction* m_jit_search_instruction;
+  QAction* m_jit_sampling_profiler;
   QAction* m_jit_off;
   QAction* m_jit_loadstore_off;
   QAction* m_jit_loadstore_lbzx_off;
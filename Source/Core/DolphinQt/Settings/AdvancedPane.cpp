@@ -87,6 +87,16 @@ void AdvancedPane::CreateLayout()
          "needed.<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>"));
   cpu_options_group_layout->addWidget(m_accurate_cpu_cache_checkbox);
 
+  m_jit_icache_check_checkbox = new ConfigBool(
+      tr("Detect Self-Modifying Code in Instruction Cache"), Config::MAIN_JIT_ICACHE_CHECK);
+  m_jit_icache_check_checkbox->SetDescription(
+      tr("Makes JIT code in regions that have been modified at runtime check whether it is still "
+         "in the emulated instruction cache. Some games modify code without invalidating the "
+         "instruction cache and rely on the old code being evicted.<br>Enabling will impact "
+         "performance in games that modify code often.<br><br><dolphin_emphasis>If unsure, leave "
+         "this unchecked.</dolphin_emphasis>"));
+  cpu_options_group_layout->addWidget(m_jit_icache_check_checkbox);
+
   auto* clock_override = new QGroupBox(tr("Clock Override"));
   auto* clock_override_layout = new QVBoxLayout();
   clock_override->setLayout(clock_override_layout);
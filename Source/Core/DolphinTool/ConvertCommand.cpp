@@ -4,10 +4,14 @@
 #include "DolphinTool/ConvertCommand.h"
 
 #include <cstdlib>
+#include <filesystem>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <OptionParser.h>
@@ -15,7 +19,11 @@
 #include <fmt/ostream.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/ChunkStore.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/ScrubbedBlob.h"
 #include "DiscIO/Volume.h"
@@ -25,6 +33,9 @@
 
 namespace DolphinTool
 {
+static const std::vector<std::string> DISC_IMAGE_EXTENSIONS = {
+    ".gcm", ".iso", ".tgc", ".ciso", ".gcz", ".wbfs", ".wia", ".rvz", ".nfs"};
+
 static std::optional<DiscIO::WIARVZCompressionType>
 ParseCompressionTypeString(const std::string& compression_str)
 {
@@ -56,94 +67,25 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
   return std::nullopt;
 }
 
-int ConvertCommand(const std::vector<std::string>& args)
+static std::string_view GetFormatExtension(DiscIO::BlobType format)
 {
-  optparse::OptionParser parser;
-
-  parser.usage("usage: convert [options]... [FILE]...");
-
-  parser.add_option("-u", "--user")
-      .type("string")
-      .action("store")
-      .help("User folder path, required for temporary processing files. "
-            "Will be automatically created if this option is not set.")
-      .set_default("");
-
-  parser.add_option("-i", "--input")
-      .type("string")
-      .action("store")
-      .help("Path to disc image FILE.")
-      .metavar("FILE");
-
-  parser.add_option("-o", "--output")
-      .type("string")
-      .action("store")
-      .help("Path to the destination FILE.")
-      .metavar("FILE");
-
-  parser.add_option("-f", "--format")
-      .type("string")
-      .action("store")
-      .help("Container format to use. Default is RVZ. [%choices]")
-      .choices({"iso", "gcz", "wia", "rvz"});
-
-  parser.add_option("-s", "--scrub")
-      .action("store_true")
-      .help("Scrub junk data as part of conversion.");
-
-  parser.add_option("-b", "--block_size")
-      .type("int")
-      .action("store")
-      .help("Block size for GCZ/WIA/RVZ formats, as an integer. Suggested value for RVZ: 131072 "
-            "(128 KiB)");
-
-  parser.add_option("-c", "--compression")
-      .type("string")
-      .action("store")
-      .help("Compression method to use when converting to WIA/RVZ. Suggested value for RVZ: zstd "
-            "[%choices]")
-      .choices({"none", "zstd", "bzip2", "lzma", "lzma2"});
-
-  parser.add_option("-l", "--compression_level")
-      .type("int")
-      .action("store")
-      .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
-            "zstd: 5");
-
-  const optparse::Values& options = parser.parse_args(args);
-
-  // Initialize the dolphin user directory, required for temporary processing files
-  // If this is not set, destructive file operations could occur due to path confusion
-  UICommon::SetUserDirectory(options["user"]);
-  UICommon::Init();
-
-  // Validate options
-
-  // --input
-  if (!options.is_set("input"))
-  {
-    fmt::print(std::cerr, "Error: No input set\n");
-    return EXIT_FAILURE;
-  }
-  const std::string& input_file_path = options["input"];
-
-  // --output
-  if (!options.is_set("output"))
-  {
-    fmt::print(std::cerr, "Error: No output set\n");
-    return EXIT_FAILURE;
-  }
-  const std::string& output_file_path = options["output"];
-
-  // --format
-  const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
-  if (!format_o.has_value())
+  switch (format)
   {
-    fmt::print(std::cerr, "Error: No output format set\n");
-    return EXIT_FAILURE;
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  default:
+    return ".iso";
   }
-  const DiscIO::BlobType format = format_o.value();
+}
 
+static int ConvertDiscImage(const optparse::Values& options, DiscIO::BlobType format,
+                            const std::string& input_file_path,
+                            const std::string& output_file_path, DiscIO::ChunkStore* chunk_store)
+{
   // Open the blob reader
   std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
   if (!blob_reader)
@@ -331,7 +273,8 @@ int ConvertCommand(const std::vector<std::string>& args)
     success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
                                         format == DiscIO::BlobType::RVZ, compression_o.value(),
                                         compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
+                                        NOOP_STATUS_CALLBACK, chunk_store,
+                                        static_cast<bool>(options.get("zstd_dictionary")));
     break;
   }
 
@@ -350,4 +293,204 @@ int ConvertCommand(const std::vector<std::string>& args)
 
   return EXIT_SUCCESS;
 }
+
+int ConvertCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: convert [options]... [FILE]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path, required for temporary processing files. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to disc image FILE, or to a directory of disc images to convert.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the destination FILE, or to the destination directory if the input is a "
+            "directory.")
+      .metavar("FILE");
+
+  parser.add_option("-f", "--format")
+      .type("string")
+      .action("store")
+      .help("Container format to use. Default is RVZ. [%choices]")
+      .choices({"iso", "gcz", "wia", "rvz"});
+
+  parser.add_option("-s", "--scrub")
+      .action("store_true")
+      .help("Scrub junk data as part of conversion.");
+
+  parser.add_option("-b", "--block_size")
+      .type("int")
+      .action("store")
+      .help("Block size for GCZ/WIA/RVZ formats, as an integer. Suggested value for RVZ: 131072 "
+            "(128 KiB)");
+
+  parser.add_option("-c", "--compression")
+      .type("string")
+      .action("store")
+      .help("Compression method to use when converting to WIA/RVZ. Suggested value for RVZ: zstd "
+            "[%choices]")
+      .choices({"none", "zstd", "bzip2", "lzma", "lzma2"});
+
+  parser.add_option("-l", "--compression_level")
+      .type("int")
+      .action("store")
+      .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
+            "zstd: 5");
+
+  parser.add_option("-z", "--zstd_dictionary")
+      .action("store_true")
+      .help("Build a Zstandard dictionary from the disc and store it in the RVZ file. Improves "
+            "compression with small block sizes. The output can't be read by versions of Dolphin "
+            "without dictionary support.");
+
+  parser.add_option("-d", "--chunk_store")
+      .type("string")
+      .action("store")
+      .help("Directory in which compressed WIA/RVZ data is kept so that it can be reused by later "
+            "conversions using the same settings. Speeds up converting other revisions or regional "
+            "variants of a game, and reconverting a library.")
+      .metavar("DIR");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Initialize the dolphin user directory, required for temporary processing files
+  // If this is not set, destructive file operations could occur due to path confusion
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  // Validate options
+
+  // --input
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& input_file_path = options["input"];
+
+  // --output
+  if (!options.is_set("output"))
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& output_file_path = options["output"];
+
+  // --format
+  const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
+  if (!format_o.has_value())
+  {
+    fmt::print(std::cerr, "Error: No output format set\n");
+    return EXIT_FAILURE;
+  }
+  const DiscIO::BlobType format = format_o.value();
+
+  // --zstd_dictionary
+  if (options.get("zstd_dictionary") &&
+      (format != DiscIO::BlobType::RVZ || options["compression"] != "zstd"))
+  {
+    fmt::print(std::cerr, "Error: A Zstandard dictionary can only be used with RVZ and zstd\n");
+    return EXIT_FAILURE;
+  }
+
+  // --chunk_store
+  std::unique_ptr<DiscIO::ChunkStore> chunk_store;
+  if (options.is_set("chunk_store"))
+  {
+    if (format != DiscIO::BlobType::WIA && format != DiscIO::BlobType::RVZ)
+    {
+      fmt::print(std::cerr, "Error: A chunk store can only be used when converting to WIA/RVZ\n");
+      return EXIT_FAILURE;
+    }
+
+    chunk_store = std::make_unique<DiscIO::ChunkStore>(options["chunk_store"]);
+  }
+
+  int result = EXIT_SUCCESS;
+
+  if (File::IsDirectory(input_file_path))
+  {
+    // Convert every disc image in the input directory into the output directory
+    if (!File::IsDirectory(output_file_path) && !File::CreateFullPath(output_file_path + '/'))
+    {
+      fmt::print(std::cerr, "Error: The output directory could not be created\n");
+      return EXIT_FAILURE;
+    }
+
+    const std::vector<std::string> input_file_paths =
+        Common::DoFileSearch({input_file_path}, DISC_IMAGE_EXTENSIONS);
+    if (input_file_paths.empty())
+    {
+      fmt::print(std::cerr, "Error: No disc images found in the input directory\n");
+      return EXIT_FAILURE;
+    }
+
+    // An image in the input directory could otherwise be truncated while it's being read
+    std::error_code error;
+    if (std::filesystem::equivalent(StringToPath(input_file_path), StringToPath(output_file_path),
+                                    error))
+    {
+      fmt::print(std::cerr, "Error: The output directory must not be the input directory\n");
+      return EXIT_FAILURE;
+    }
+
+    // Images that only differ in their extension would be converted to the same output file
+    std::map<std::string, std::string> output_to_input_paths;
+    for (const std::string& path : input_file_paths)
+    {
+      std::string name;
+      SplitPath(path, nullptr, &name, nullptr);
+      const std::string output_path =
+          fmt::format("{}/{}{}", output_file_path, name, GetFormatExtension(format));
+
+      const auto [it, inserted] = output_to_input_paths.emplace(output_path, path);
+      if (!inserted)
+      {
+        fmt::print(std::cerr, "Error: {} and {} would both be converted to {}\n", it->second,
+                   path, output_path);
+        return EXIT_FAILURE;
+      }
+    }
+
+    size_t failures = 0;
+    for (const auto& [output_path, path] : output_to_input_paths)
+    {
+      fmt::print(std::cout, "Converting {}\n", path);
+      if (ConvertDiscImage(options, format, path, output_path, chunk_store.get()) != EXIT_SUCCESS)
+        ++failures;
+    }
+
+    if (failures != 0)
+    {
+      fmt::print(std::cerr, "Error: {} of {} disc images could not be converted\n", failures,
+                 input_file_paths.size());
+      result = EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    result = ConvertDiscImage(options, format, input_file_path, output_file_path,
+                              chunk_store.get());
+  }
+
+  if (chunk_store)
+  {
+    fmt::print(std::cout, "Chunk store: {} chunks reused, {} chunks compressed\n",
+               chunk_store->GetHits(), chunk_store->GetMisses());
+  }
+
+  return result;
+}
 }  // namespace DolphinTool
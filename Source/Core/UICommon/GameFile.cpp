@@ -7,6 +7,7 @@
 #include <array>
 #include <cstdio>
 #include <cstring>
+#include <filesystem>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -53,6 +54,13 @@ namespace
 {
 const std::string EMPTY_STRING;
 
+s64 GetModificationTime(const std::string& path)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(StringToPath(path), error);
+  return error ? 0 : static_cast<s64>(time.time_since_epoch().count());
+}
+
 bool UseGameCovers()
 {
 #ifdef ANDROID
@@ -105,6 +113,11 @@ GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 {
   m_file_name = PathToFileName(m_file_path);
 
+  // This is checked before reading anything, so that a file which is modified while being scanned
+  // gets scanned again the next time
+  m_file_stat_size = File::GetSize(m_file_path);
+  m_file_modification_time = GetModificationTime(m_file_path);
+
   {
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolume(m_file_path));
     if (volume != nullptr)
@@ -197,6 +210,12 @@ bool GameFile::IsValid() const
   return true;
 }
 
+bool GameFile::FileChanged() const
+{
+  return File::GetSize(m_file_path) != m_file_stat_size ||
+         GetModificationTime(m_file_path) != m_file_modification_time;
+}
+
 bool GameFile::CustomCoverChanged()
 {
   if (!m_custom_cover.buffer.empty() || !UseGameCovers())
@@ -295,6 +314,8 @@ void GameFile::DoState(PointerWrap& p)
   p.Do(m_valid);
   p.Do(m_file_path);
   p.Do(m_file_name);
+  p.Do(m_file_stat_size);
+  p.Do(m_file_modification_time);
 
   p.Do(m_file_size);
   p.Do(m_volume_size);
@@ -57,6 +57,8 @@ public:
   ~GameFile();
 
   bool IsValid() const;
+  // Returns true if the file has been modified since it was scanned.
+  bool FileChanged() const;
   const std::string& GetFilePath() const { return m_file_path; }
   const std::string& GetFileName() const { return m_file_name; }
   const std::string& GetName(const Core::TitleDatabase& title_database) const;
@@ -142,6 +144,9 @@ private:
   bool m_valid{};
   std::string m_file_path;
   std::string m_file_name;
+  // The size and modification time of the file at m_file_path when it was scanned
+  u64 m_file_stat_size{};
+  s64 m_file_modification_time{};
 
   u64 m_file_size{};
   u64 m_volume_size{};
@@ -4,12 +4,15 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -19,6 +22,7 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Thread.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -26,7 +30,11 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 24;  // Last changed in PR 11557
+static constexpr u32 CACHE_REVISION = 25;  // Last changed to add file modification times
+
+// Scanning a game is mostly spent waiting for small reads (especially when the games are on a
+// network drive), so several games are scanned at once. This limits how many reads are in flight.
+static constexpr size_t MAX_CONCURRENT_SCANS = 8;
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -39,6 +47,65 @@ std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& direct
   return Common::DoFileSearch(directories_to_scan, search_extensions, recursive_scan);
 }
 
+// Scans the games at the given paths on several threads. The callback is called on the calling
+// thread for each valid game as soon as it has been scanned, in no particular order.
+static void ScanGameFiles(const std::vector<std::string>& paths,
+                          const std::function<void(std::shared_ptr<GameFile>)>& callback,
+                          const std::atomic_bool& processing_halted)
+{
+  const size_t thread_count = std::min(paths.size(), MAX_CONCURRENT_SCANS);
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::vector<std::shared_ptr<GameFile>> scanned_files;
+  size_t finished_threads = 0;
+  std::atomic<size_t> next_path = 0;
+
+  const auto scan = [&] {
+    Common::SetCurrentThreadName("Game List Scan");
+
+    for (size_t i = next_path++; i < paths.size() && !processing_halted; i = next_path++)
+    {
+      auto file = std::make_shared<GameFile>(paths[i]);
+
+      std::lock_guard lk(mutex);
+      scanned_files.push_back(std::move(file));
+      cond.notify_one();
+    }
+
+    std::lock_guard lk(mutex);
+    ++finished_threads;
+    cond.notify_one();
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i)
+    threads.emplace_back(scan);
+
+  std::vector<std::shared_ptr<GameFile>> batch;
+  while (true)
+  {
+    {
+      std::unique_lock lk(mutex);
+      cond.wait(lk, [&] { return !scanned_files.empty() || finished_threads == thread_count; });
+      if (scanned_files.empty())
+        break;
+      std::swap(batch, scanned_files);
+    }
+
+    for (std::shared_ptr<GameFile>& file : batch)
+    {
+      if (file->IsValid())
+        callback(std::move(file));
+    }
+    batch.clear();
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
 GameFileCache::GameFileCache() : m_path(File::GetUserPath(D_CACHE_IDX) + "gamelist.cache")
 {
 }
@@ -69,15 +136,27 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
       m_cached_files.begin(), m_cached_files.end(),
       [&path](const std::shared_ptr<GameFile>& file) { return file->GetFilePath() == path; });
   const bool found = it != m_cached_files.cend();
-  if (!found)
+  const bool changed = found && (*it)->FileChanged();
+  if (!found || changed)
   {
     std::shared_ptr<UICommon::GameFile> game = std::make_shared<GameFile>(path);
     if (!game->IsValid())
+    {
+      if (changed)
+      {
+        m_cached_files.erase(it);
+        *cache_changed = true;
+      }
       return nullptr;
-    m_cached_files.emplace_back(std::move(game));
+    }
+
+    if (changed)
+      *it = std::move(game);
+    else
+      m_cached_files.emplace_back(std::move(game));
   }
   std::shared_ptr<GameFile>& result = found ? *it : m_cached_files.back();
-  if (UpdateAdditionalMetadata(&result) || !found)
+  if (UpdateAdditionalMetadata(&result) || !found || changed)
     *cache_changed = true;
 
   return result;
@@ -103,6 +182,8 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
 
   // Delete paths that aren't in game_paths from m_cached_files,
   // while simultaneously deleting paths that are in m_cached_files from game_paths.
+  // Files that have been modified since they were scanned are also deleted from m_cached_files,
+  // but stay in game_paths so that they get scanned again.
   // For the sake of speed, we don't care about maintaining the order of m_cached_files.
   {
     auto it = m_cached_files.begin();
@@ -112,8 +193,10 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
       if (processing_halted)
         break;
 
-      if (game_paths.erase((*it)->GetFilePath()))
+      const auto path_it = game_paths.find((*it)->GetFilePath());
+      if (path_it != game_paths.end() && !(*it)->FileChanged())
       {
+        game_paths.erase(path_it);
         ++it;
       }
       else
@@ -131,21 +214,17 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
-  {
-    if (processing_halted)
-      break;
-
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
-    {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+  const std::vector<std::string> paths_to_scan(game_paths.begin(), game_paths.end());
+  ScanGameFiles(
+      paths_to_scan,
+      [&](std::shared_ptr<GameFile> file) {
+        if (game_added_to_cache)
+          game_added_to_cache(file);
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
-    }
-  }
+        cache_changed = true;
+        m_cached_files.push_back(std::move(file));
+      },
+      processing_halted);
 
   return cache_changed;
 }
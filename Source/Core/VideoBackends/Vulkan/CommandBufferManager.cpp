@@ -226,6 +226,15 @@ bool CommandBufferManager::CreateSubmitThread()
                         submit.present_image_index);
     CmdBufferResources& resources = m_command_buffers[submit.command_buffer_index];
     resources.waiting_for_submit.store(false, std::memory_order_release);
+
+    if (submit.present_swap_chain != VK_NULL_HANDLE)
+    {
+      {
+        std::lock_guard lock(m_pending_presents_mutex);
+        m_pending_presents--;
+      }
+      m_pending_presents_cv.notify_all();
+    }
   });
 
   return true;
@@ -239,6 +248,18 @@ void CommandBufferManager::WaitForWorkerThreadIdle()
   m_submit_thread.WaitForCompletion();
 }
 
+u32 CommandBufferManager::GetPendingPresentCount()
+{
+  std::lock_guard lock(m_pending_presents_mutex);
+  return m_pending_presents;
+}
+
+void CommandBufferManager::WaitForPendingPresents(u32 max_pending)
+{
+  std::unique_lock lock(m_pending_presents_mutex);
+  m_pending_presents_cv.wait(lock, [&] { return m_pending_presents <= max_pending; });
+}
+
 void CommandBufferManager::WaitForFenceCounter(u64 fence_counter)
 {
   if (m_completed_fence_counter >= fence_counter)
@@ -321,6 +342,12 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
   if (m_use_threaded_submission && submit_on_worker_thread && !wait_for_completion)
   {
     resources.waiting_for_submit.store(true, std::memory_order_relaxed);
+    if (present_swap_chain != VK_NULL_HANDLE)
+    {
+      std::lock_guard lock(m_pending_presents_mutex);
+      m_pending_presents++;
+    }
+
     // Push to the pending submit queue.
     m_submit_thread.Push({present_swap_chain, present_image_index, m_current_cmd_buffer});
   }
@@ -439,8 +466,11 @@ void CommandBufferManager::SubmitCommandBuffer(u32 command_buffer_index,
                                      &present_image_index,
                                      nullptr};
 
-    m_last_present_result = vkQueuePresentKHR(g_vulkan_context->GetPresentQueue(), &present_info);
-    m_last_present_done.Set();
+    {
+      std::lock_guard lock(m_present_mutex);
+      m_last_present_result =
+          vkQueuePresentKHR(g_vulkan_context->GetPresentQueue(), &present_info);
+    }
     if (m_last_present_result != VK_SUCCESS)
     {
       // VK_ERROR_OUT_OF_DATE_KHR is not fatal, just means we need to recreate our swap chain.
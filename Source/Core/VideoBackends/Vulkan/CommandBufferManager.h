@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <cstddef>
 #include <deque>
 #include <functional>
@@ -84,7 +85,16 @@ public:
   // Was the last present submitted to the queue a failure? If so, we must recreate our swapchain.
   bool CheckLastPresentFail() { return m_last_present_failed.TestAndClear(); }
   VkResult GetLastPresentResult() const { return m_last_present_result; }
-  bool CheckLastPresentDone() { return m_last_present_done.TestAndClear(); }
+
+  // Returns the number of presents which have been queued but not yet executed by the worker.
+  u32 GetPendingPresentCount();
+
+  // Blocks until no more than max_pending presents are waiting on the worker thread.
+  void WaitForPendingPresents(u32 max_pending);
+
+  // The swap chain must be externally synchronized, so this mutex is held by the worker thread
+  // while presenting, and must be held by the caller while acquiring swap chain images.
+  std::mutex& GetPresentMutex() { return m_present_mutex; }
 
   // Schedule a vulkan resource for destruction later on. This will occur when the command buffer
   // is next re-used, and the GPU has finished working with the specified resource.
@@ -156,8 +166,11 @@ private:
   Common::WorkQueueThread<PendingCommandBufferSubmit> m_submit_thread;
   VkSemaphore m_present_semaphore = VK_NULL_HANDLE;
   Common::Flag m_last_present_failed;
-  Common::Flag m_last_present_done;
   VkResult m_last_present_result = VK_SUCCESS;
+  std::mutex m_present_mutex;
+  std::mutex m_pending_presents_mutex;
+  std::condition_variable m_pending_presents_cv;
+  u32 m_pending_presents = 0;
   bool m_use_threaded_submission = false;
   u32 m_descriptor_set_count = DESCRIPTOR_SETS_PER_POOL;
 };
@@ -29,6 +29,7 @@
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/RenderState.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace Vulkan
@@ -225,19 +226,28 @@ void VKGfx::BindBackbuffer(const ClearColor& clear_color)
 {
   StateTracker::GetInstance()->EndRenderPass();
 
-  if (!g_command_buffer_mgr->CheckLastPresentDone())
-    g_command_buffer_mgr->WaitForWorkerThreadIdle();
+  // Allow the worker thread to still be presenting earlier frames while we render this one, up to
+  // the number of images the swap chain lets us have outstanding.
+  const u32 max_queued_presents =
+      std::min(static_cast<u32>(g_ActiveConfig.iPresentQueueDepth),
+               m_swap_chain->GetMaxQueuedPresents());
+  SETSTAT(g_stats.present_queue_depth, g_command_buffer_mgr->GetPendingPresentCount());
+  g_command_buffer_mgr->WaitForPendingPresents(max_queued_presents - 1);
 
   // Handle host window resizes.
   CheckForSurfaceChange();
   CheckForSurfaceResize();
 
   // Check for exclusive fullscreen request.
-  if (m_swap_chain->GetCurrentFullscreenState() != m_swap_chain->GetNextFullscreenState() &&
-      !m_swap_chain->SetFullscreenState(m_swap_chain->GetNextFullscreenState()))
+  if (m_swap_chain->GetCurrentFullscreenState() != m_swap_chain->GetNextFullscreenState())
   {
-    // if it fails, don't keep trying
-    m_swap_chain->SetNextFullscreenState(m_swap_chain->GetCurrentFullscreenState());
+    // Changing fullscreen state can't race with queued presents.
+    g_command_buffer_mgr->WaitForWorkerThreadIdle();
+    if (!m_swap_chain->SetFullscreenState(m_swap_chain->GetNextFullscreenState()))
+    {
+      // if it fails, don't keep trying
+      m_swap_chain->SetNextFullscreenState(m_swap_chain->GetCurrentFullscreenState());
+    }
   }
 
   const bool present_fail = g_command_buffer_mgr->CheckLastPresentFail();
@@ -397,6 +407,12 @@ void VKGfx::OnConfigChanged(u32 bits)
     ExecuteCommandBuffer(false, true);
     m_swap_chain->SetVSync(g_ActiveConfig.bVSyncActive);
   }
+  else if (m_swap_chain && (bits & CONFIG_CHANGE_BIT_PRESENT_MODE))
+  {
+    // The present mode and image count are chosen when the swap chain is created.
+    ExecuteCommandBuffer(false, true);
+    m_swap_chain->RecreateSwapChain();
+  }
 
   // For quad-buffered stereo we need to change the layer count, so recreate the swap chain.
   if (m_swap_chain && ((bits & CONFIG_CHANGE_BIT_STEREO_MODE) || (bits & CONFIG_CHANGE_BIT_HDR)))
@@ -16,6 +16,7 @@
 #include "VideoBackends/Vulkan/VKTexture.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/VideoConfig.h"
 
 #if defined(VK_USE_PLATFORM_XLIB_KHR)
 #include <X11/Xlib.h>
@@ -248,6 +249,15 @@ bool SwapChain::SelectPresentMode()
     return it != present_modes.end();
   };
 
+  // Mailbox presentation avoids tearing without blocking on vblank, at the cost of dropped
+  // frames, so only use it with vsync if the user asked for it.
+  if (m_vsync_enabled && g_ActiveConfig.bPreferMailboxPresent &&
+      CheckForMode(VK_PRESENT_MODE_MAILBOX_KHR))
+  {
+    m_present_mode = VK_PRESENT_MODE_MAILBOX_KHR;
+    return true;
+  }
+
   // If vsync is enabled, use VK_PRESENT_MODE_FIFO_KHR.
   // This check should not fail with conforming drivers, as the FIFO present mode is mandated by
   // the specification (VK_KHR_swapchain). In case it isn't though, fall through to any other mode.
@@ -292,13 +302,18 @@ bool SwapChain::CreateSwapChain()
   if (!SelectSurfaceFormat() || !SelectPresentMode())
     return false;
 
-  // Select number of images in swap chain, we prefer one buffer in the background to work on
-  uint32_t image_count = surface_capabilities.minImageCount + 1;
+  // Select number of images in swap chain, we prefer one buffer in the background to work on,
+  // plus one for each additional frame which can be queued for presentation.
+  uint32_t image_count =
+      surface_capabilities.minImageCount + static_cast<u32>(g_ActiveConfig.iPresentQueueDepth);
 
   // maxImageCount can be zero, in which case there isn't an upper limit on the number of buffers.
   if (surface_capabilities.maxImageCount > 0)
     image_count = std::min(image_count, surface_capabilities.maxImageCount);
 
+  // Acquiring more images than this without a timeout is not allowed.
+  m_max_queued_presents = std::max(image_count - surface_capabilities.minImageCount, 1u);
+
   // Determine the dimensions of the swap chain. Values of -1 indicate the size we specify here
   // determines window size?
   VkExtent2D size = surface_capabilities.currentExtent;
@@ -494,6 +509,7 @@ void SwapChain::DestroySwapChain()
 
 VkResult SwapChain::AcquireNextImage()
 {
+  std::lock_guard lock(g_command_buffer_mgr->GetPresentMutex());
   VkResult res = vkAcquireNextImageKHR(g_vulkan_context->GetDevice(), m_swap_chain, UINT64_MAX,
                                        g_command_buffer_mgr->GetCurrentCommandBufferSemaphore(),
                                        VK_NULL_HANDLE, &m_current_swap_chain_image_index);
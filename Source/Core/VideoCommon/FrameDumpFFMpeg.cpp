@@ -7,9 +7,14 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -42,15 +47,30 @@ extern "C" {
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
+// Number of colour-converted frames that may be waiting for or undergoing encoding at once.
+// When the encoder falls further behind than this, conversion blocks until a buffer is released.
+constexpr size_t FRAME_DUMP_QUEUE_SIZE = 4;
+
 struct FrameDumpContext
 {
   AVFormatContext* format = nullptr;
   AVStream* stream = nullptr;
   AVCodecContext* codec = nullptr;
   AVFrame* src_frame = nullptr;
-  AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
 
+  // Converted frame buffers. Owned by the context, lent to the encoder thread while queued.
+  std::array<AVFrame*, FRAME_DUMP_QUEUE_SIZE> scaled_frames{};
+  std::vector<AVFrame*> free_frames;
+  std::mutex free_frames_lock;
+  std::condition_variable free_frames_cv;
+
+  // Back-pressure statistics, reported when the dump is stopped.
+  u64 frames_queued = 0;
+  u64 queue_stalls = 0;
+  size_t peak_queue_depth = 0;
+  std::chrono::steady_clock::duration stall_time{};
+
   s64 last_pts = AV_NOPTS_VALUE;
 
   int width = 0;
@@ -158,6 +178,55 @@ std::string AVErrorString(int error)
   return fmt::format("{:8x} {}", (u32)error, &msg[0]);
 }
 
+bool SupportsPixelFormat(const AVCodec* codec, AVPixelFormat pix_fmt)
+{
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(61, 13, 100)
+  const void* configs = nullptr;
+  if (avcodec_get_supported_config(nullptr, codec, AV_CODEC_CONFIG_PIX_FORMAT, 0, &configs,
+                                   nullptr) < 0)
+  {
+    return false;
+  }
+  const auto* pix_fmts = static_cast<const AVPixelFormat*>(configs);
+#else
+  const AVPixelFormat* pix_fmts = codec->pix_fmts;
+#endif
+
+  // A null list means the encoder accepts anything.
+  if (!pix_fmts)
+    return true;
+
+  for (const AVPixelFormat* fmt = pix_fmts; *fmt != AV_PIX_FMT_NONE; ++fmt)
+  {
+    if (*fmt == pix_fmt)
+      return true;
+  }
+  return false;
+}
+
+// Hardware encoders for the given codec that can take frames directly from system memory.
+// Encoders that only accept hardware surfaces (e.g. VAAPI) are skipped, as we would otherwise
+// need to set up a hardware frames context just to upload the converted frame again.
+std::vector<const AVCodec*> GetHardwareEncoders(AVCodecID codec_id, AVPixelFormat pix_fmt)
+{
+  std::vector<const AVCodec*> encoders;
+
+  void* iter = nullptr;
+  while (const AVCodec* codec = av_codec_iterate(&iter))
+  {
+    if (codec->id != codec_id || !av_codec_is_encoder(codec) ||
+        !(codec->capabilities & AV_CODEC_CAP_HARDWARE))
+    {
+      continue;
+    }
+
+    if (SupportsPixelFormat(codec, pix_fmt))
+      encoders.push_back(codec);
+  }
+
+  return encoders;
+}
+
 }  // namespace
 
 bool FFMpegFrameDump::Start(int w, int h, u64 start_ticks)
@@ -241,30 +310,12 @@ bool FFMpegFrameDump::CreateVideoFile()
   if (!codec)
     codec = avcodec_find_encoder(codec_id);
 
-  m_context->codec = avcodec_alloc_context3(codec);
-  if (!codec || !m_context->codec)
+  if (!codec)
   {
-    ERROR_LOG_FMT(FRAMEDUMP, "Could not find encoder or allocate codec context");
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not find encoder");
     return false;
   }
 
-  // Force XVID FourCC for better compatibility when using H.263
-  if (codec->id == AV_CODEC_ID_MPEG4)
-    m_context->codec->codec_tag = MKTAG('X', 'V', 'I', 'D');
-
-  const auto time_base = GetTimeBaseForCurrentRefreshRate();
-
-  INFO_LOG_FMT(FRAMEDUMP, "Creating video file: {} x {} @ {}/{} fps", m_context->width,
-               m_context->height, time_base.den, time_base.num);
-
-  m_context->codec->codec_type = AVMEDIA_TYPE_VIDEO;
-  m_context->codec->bit_rate = static_cast<int64_t>(g_Config.iBitrateKbps) * 1000;
-  m_context->codec->width = m_context->width;
-  m_context->codec->height = m_context->height;
-  m_context->codec->time_base = time_base;
-  m_context->codec->gop_size = 1;
-  m_context->codec->level = 1;
-
   AVPixelFormat pix_fmt = AV_PIX_FMT_NONE;
 
   const std::string& pixel_format_string = g_Config.sDumpPixelFormat;
@@ -277,37 +328,92 @@ bool FFMpegFrameDump::CreateVideoFile()
 
   if (pix_fmt == AV_PIX_FMT_NONE)
   {
-    if (m_context->codec->codec_id == AV_CODEC_ID_FFV1)
+    if (codec->id == AV_CODEC_ID_FFV1)
       pix_fmt = AV_PIX_FMT_BGR0;
-    else if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
+    else if (codec->id == AV_CODEC_ID_UTVIDEO)
       pix_fmt = AV_PIX_FMT_GBRP;
     else
       pix_fmt = AV_PIX_FMT_YUV420P;
   }
 
-  m_context->codec->pix_fmt = pix_fmt;
+  // Prefer a hardware encoder when one is available, falling back to the software encoder if
+  // none of them can be opened (e.g. missing driver support on this machine).
+  std::vector<const AVCodec*> candidates;
+  if (g_Config.bDumpHardwareEncoder && g_Config.sDumpEncoder.empty() &&
+      !(codec->capabilities & AV_CODEC_CAP_HARDWARE))
+  {
+    candidates = GetHardwareEncoders(codec->id, pix_fmt);
+  }
+  candidates.push_back(codec);
 
-  if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
-    av_opt_set_int(m_context->codec->priv_data, "pred", 3, 0);  // median
+  const auto time_base = GetTimeBaseForCurrentRefreshRate();
 
-  if (output_format->flags & AVFMT_GLOBALHEADER)
-    m_context->codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+  INFO_LOG_FMT(FRAMEDUMP, "Creating video file: {} x {} @ {}/{} fps", m_context->width,
+               m_context->height, time_base.den, time_base.num);
 
-  if (avcodec_open2(m_context->codec, codec, nullptr) < 0)
+  for (const AVCodec* candidate : candidates)
   {
-    ERROR_LOG_FMT(FRAMEDUMP, "Could not open codec");
-    return false;
+    avcodec_free_context(&m_context->codec);
+    m_context->codec = avcodec_alloc_context3(candidate);
+    if (!m_context->codec)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not allocate codec context");
+      return false;
+    }
+
+    // Force XVID FourCC for better compatibility when using H.263
+    if (candidate->id == AV_CODEC_ID_MPEG4)
+      m_context->codec->codec_tag = MKTAG('X', 'V', 'I', 'D');
+
+    m_context->codec->codec_type = AVMEDIA_TYPE_VIDEO;
+    m_context->codec->bit_rate = static_cast<int64_t>(g_Config.iBitrateKbps) * 1000;
+    m_context->codec->width = m_context->width;
+    m_context->codec->height = m_context->height;
+    m_context->codec->time_base = time_base;
+    m_context->codec->gop_size = 1;
+    m_context->codec->level = 1;
+    m_context->codec->pix_fmt = pix_fmt;
+
+    if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
+      av_opt_set_int(m_context->codec->priv_data, "pred", 3, 0);  // median
+
+    if (output_format->flags & AVFMT_GLOBALHEADER)
+      m_context->codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+    if (avcodec_open2(m_context->codec, candidate, nullptr) >= 0)
+    {
+      codec = candidate;
+      break;
+    }
+
+    WARN_LOG_FMT(FRAMEDUMP, "Could not open encoder {}", candidate->name);
+    if (candidate == candidates.back())
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not open codec");
+      return false;
+    }
   }
 
+  INFO_LOG_FMT(FRAMEDUMP, "Using encoder {}", codec->name);
+
   m_context->src_frame = av_frame_alloc();
-  m_context->scaled_frame = av_frame_alloc();
 
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
-  m_context->scaled_frame->width = m_context->width;
-  m_context->scaled_frame->height = m_context->height;
+  m_context->free_frames.clear();
+  for (AVFrame*& scaled_frame : m_context->scaled_frames)
+  {
+    scaled_frame = av_frame_alloc();
+    if (!scaled_frame)
+      return false;
 
-  if (av_frame_get_buffer(m_context->scaled_frame, 1))
-    return false;
+    scaled_frame->format = m_context->codec->pix_fmt;
+    scaled_frame->width = m_context->width;
+    scaled_frame->height = m_context->height;
+
+    if (av_frame_get_buffer(scaled_frame, 1))
+      return false;
+
+    m_context->free_frames.push_back(scaled_frame);
+  }
 
   m_context->stream = avformat_new_stream(m_context->format, codec);
   if (!m_context->stream ||
@@ -333,6 +439,8 @@ bool FFMpegFrameDump::CreateVideoFile()
                  m_context->stream->time_base.num);
   }
 
+  m_encode_thread.Reset("FrameDumpEncoder", [this](AVFrame* frame) { EncodeFrame(frame); });
+
   OSD::AddMessage(fmt::format("Dumping Frames to \"{}\" ({}x{})", dump_path, m_context->width,
                               m_context->height));
   return true;
@@ -384,26 +492,69 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
   m_context->src_frame->width = m_context->width;
   m_context->src_frame->height = m_context->height;
 
-  // Convert image from RGBA to desired pixel format.
+  AVFrame* const scaled_frame = AcquireConvertedFrame();
+
+  // The encoder may still hold a reference to this buffer from a previous frame.
+  if (const int error = av_frame_make_writable(scaled_frame))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not make frame writable: {}", AVErrorString(error));
+    std::lock_guard lk(m_context->free_frames_lock);
+    m_context->free_frames.push_back(scaled_frame);
+    return;
+  }
+
+  // Convert image from RGBA to desired pixel format. This copies the frame out of the readback
+  // texture, so the caller is free to reuse it as soon as we return.
   m_context->sws = sws_getCachedContext(
       m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
       m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
   if (m_context->sws)
   {
     sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+              frame.height, scaled_frame->data, scaled_frame->linesize);
   }
 
   m_context->last_pts = pts;
-  m_context->scaled_frame->pts = pts;
+  scaled_frame->pts = pts;
+
+  m_encode_thread.Push(scaled_frame);
+}
+
+AVFrame* FFMpegFrameDump::AcquireConvertedFrame()
+{
+  std::unique_lock lk(m_context->free_frames_lock);
 
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
+  ++m_context->frames_queued;
+
+  if (m_context->free_frames.empty())
   {
-    ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
-    return;
+    // The encoder can't keep up. Wait for it rather than dropping frames.
+    const auto stall_start = std::chrono::steady_clock::now();
+    m_context->free_frames_cv.wait(lk, [this] { return !m_context->free_frames.empty(); });
+    m_context->stall_time += std::chrono::steady_clock::now() - stall_start;
+    ++m_context->queue_stalls;
   }
 
-  ProcessPackets();
+  AVFrame* const frame = m_context->free_frames.back();
+  m_context->free_frames.pop_back();
+
+  const size_t queue_depth = FRAME_DUMP_QUEUE_SIZE - m_context->free_frames.size();
+  m_context->peak_queue_depth = std::max(m_context->peak_queue_depth, queue_depth);
+  return frame;
+}
+
+void FFMpegFrameDump::EncodeFrame(AVFrame* frame)
+{
+  if (const int error = avcodec_send_frame(m_context->codec, frame))
+    ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
+  else
+    ProcessPackets();
+
+  {
+    std::lock_guard lk(m_context->free_frames_lock);
+    m_context->free_frames.push_back(frame);
+  }
+  m_context->free_frames_cv.notify_one();
 }
 
 void FFMpegFrameDump::ProcessPackets()
@@ -449,6 +600,17 @@ void FFMpegFrameDump::Stop()
   if (!IsStarted())
     return;
 
+  // Wait for all queued frames to be encoded.
+  m_encode_thread.Shutdown();
+
+  const auto stall_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(m_context->stall_time).count();
+  NOTICE_LOG_FMT(FRAMEDUMP,
+                 "Encoder queue: {} frames, peak depth {}/{}, {} stalls waiting for encoder "
+                 "({} ms)",
+                 m_context->frames_queued, m_context->peak_queue_depth, FRAME_DUMP_QUEUE_SIZE,
+                 m_context->queue_stalls, stall_ms);
+
   // Signal end of stream to encoder.
   if (const int flush_error = avcodec_send_frame(m_context->codec, nullptr))
     WARN_LOG_FMT(FRAMEDUMP, "Error sending flush packet: {}", AVErrorString(flush_error));
@@ -468,8 +630,12 @@ bool FFMpegFrameDump::IsStarted() const
 
 void FFMpegFrameDump::CloseVideoFile()
 {
+  // The encoder thread must not be running when the frames are freed.
+  m_encode_thread.Shutdown(true);
+
   av_frame_free(&m_context->src_frame);
-  av_frame_free(&m_context->scaled_frame);
+  for (AVFrame*& scaled_frame : m_context->scaled_frames)
+    av_frame_free(&scaled_frame);
 
   avcodec_free_context(&m_context->codec);
 
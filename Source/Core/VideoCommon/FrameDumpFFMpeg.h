@@ -7,7 +7,9 @@
 #include <memory>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 
+struct AVFrame;
 struct FrameDumpContext;
 class PointerWrap;
 
@@ -52,8 +54,17 @@ private:
   void CheckForConfigChange(const FrameData&);
   void ProcessPackets();
 
+  // Blocks until one of the converted frame buffers is no longer in use by the encoder.
+  AVFrame* AcquireConvertedFrame();
+  // NOTE: Called on the encoder thread.
+  void EncodeFrame(AVFrame* frame);
+
 #if defined(HAVE_FFMPEG)
   std::unique_ptr<FrameDumpContext> m_context;
+
+  // Colour-converted frames are handed to this thread so that encoding of one frame overlaps
+  // with the readback and conversion of the next.
+  Common::WorkQueueThread<AVFrame*> m_encode_thread;
 #endif
 
   // Used for FetchState:
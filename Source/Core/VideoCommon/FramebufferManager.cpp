@@ -22,6 +22,7 @@
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -399,6 +400,8 @@ bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
   std::swap(m_efb_framebuffer, m_efb_convert_framebuffer);
   g_gfx->EndUtilityDrawing();
   InvalidatePeekCache(true);
+  // Previously read back values are in the old pixel format.
+  DiscardStaleEFBCacheTiles();
   return true;
 }
 
@@ -479,7 +482,7 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
     y = EFB_HEIGHT - 1 - y;
 
   u32 tile_index;
-  if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
+  if (!IsEFBCacheTilePresent(false, x, y, &tile_index) && !UseStaleEFBCacheTile(false, tile_index))
     PopulateEFBCache(false, tile_index);
 
   m_efb_color_cache.tiles[tile_index].frame_access_mask |= 1;
@@ -502,7 +505,7 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
     y = EFB_HEIGHT - 1 - y;
 
   u32 tile_index;
-  if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
+  if (!IsEFBCacheTilePresent(true, x, y, &tile_index) && !UseStaleEFBCacheTile(true, tile_index))
     PopulateEFBCache(true, tile_index);
 
   m_efb_depth_cache.tiles[tile_index].frame_access_mask |= 1;
@@ -518,6 +521,31 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
   return value;
 }
 
+bool FramebufferManager::UseStaleEFBCacheTile(bool depth, u32 tile_index)
+{
+  if (!g_ActiveConfig.bEFBAccessAsyncPeeks)
+    return false;
+
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  if (!data.tiles[tile_index].stale)
+    return false;
+
+  // Return the previous contents of the tile instead of waiting for the GPU. The caller marks the
+  // tile as accessed, so the next RefreshPeekCache() will fetch it asynchronously, making the
+  // result at most one synchronization point late.
+  data.needs_refresh = true;
+  INCSTAT(g_stats.this_frame.num_efb_peeks_stale);
+  return true;
+}
+
+void FramebufferManager::DiscardStaleEFBCacheTiles()
+{
+  for (EFBCacheTile& tile : m_efb_color_cache.tiles)
+    tile.stale = false;
+  for (EFBCacheTile& tile : m_efb_depth_cache.tiles)
+    tile.stale = false;
+}
+
 void FramebufferManager::SetEFBCacheTileSize(u32 size)
 {
   if (m_efb_cache_tile_size == size)
@@ -570,6 +598,7 @@ void FramebufferManager::InvalidatePeekCache(bool forced)
     {
       for (u32 i = 0; i < m_efb_color_cache.tiles.size(); i++)
       {
+        m_efb_color_cache.tiles[i].stale |= m_efb_color_cache.tiles[i].present;
         m_efb_color_cache.tiles[i].present = false;
       }
 
@@ -585,6 +614,7 @@ void FramebufferManager::InvalidatePeekCache(bool forced)
     {
       for (u32 i = 0; i < m_efb_depth_cache.tiles.size(); i++)
       {
+        m_efb_depth_cache.tiles[i].stale |= m_efb_depth_cache.tiles[i].present;
         m_efb_depth_cache.tiles[i].present = false;
       }
 
@@ -760,9 +790,11 @@ bool FramebufferManager::CreateReadbackFramebuffer()
   }
 
   m_efb_color_cache.tiles.resize(total_tiles);
-  std::fill(m_efb_color_cache.tiles.begin(), m_efb_color_cache.tiles.end(), EFBCacheTile{false, 0});
+  std::fill(m_efb_color_cache.tiles.begin(), m_efb_color_cache.tiles.end(),
+            EFBCacheTile{false, false, 0});
   m_efb_depth_cache.tiles.resize(total_tiles);
-  std::fill(m_efb_depth_cache.tiles.begin(), m_efb_depth_cache.tiles.end(), EFBCacheTile{false, 0});
+  std::fill(m_efb_depth_cache.tiles.begin(), m_efb_depth_cache.tiles.end(),
+            EFBCacheTile{false, false, 0});
 
   return true;
 }
@@ -843,14 +875,17 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index, bool async
   {
     data.readback_texture->Flush();
     data.needs_flush = false;
+    INCSTAT(g_stats.this_frame.num_efb_peek_stalls);
   }
   else
   {
     data.needs_flush = true;
+    INCSTAT(g_stats.this_frame.num_efb_tiles_prefetched);
   }
   data.has_active_tiles = true;
   data.out_of_date = false;
   data.tiles[tile_index].present = true;
+  data.tiles[tile_index].stale = false;
 }
 
 void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool color_enable,
@@ -957,8 +992,11 @@ void FramebufferManager::PokeEFBColor(u32 x, u32 y, u32 color)
 
   // Update the peek cache if it's valid, since we know the color of the pixel now.
   u32 tile_index;
-  if (IsEFBCacheTilePresent(false, x, y, &tile_index))
+  if (IsEFBCacheTilePresent(false, x, y, &tile_index) ||
+      m_efb_color_cache.tiles[tile_index].stale)
+  {
     m_efb_color_cache.readback_texture->WriteTexel(x, y, &color);
+  }
 }
 
 void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
@@ -975,7 +1013,7 @@ void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
 
   // Update the peek cache if it's valid, since we know the color of the pixel now.
   u32 tile_index;
-  if (IsEFBCacheTilePresent(true, x, y, &tile_index))
+  if (IsEFBCacheTilePresent(true, x, y, &tile_index) || m_efb_depth_cache.tiles[tile_index].stale)
     m_efb_depth_cache.readback_texture->WriteTexel(x, y, &depth);
 }
 
@@ -1140,6 +1178,7 @@ void FramebufferManager::DoLoadState(PointerWrap& p)
 {
   // Invalidate any peek cache tiles.
   InvalidatePeekCache(true);
+  DiscardStaleEFBCacheTiles();
 
   // Deserialize the color and depth textures. This could fail.
   auto color_tex = g_texture_cache->DeserializeTexture(p);
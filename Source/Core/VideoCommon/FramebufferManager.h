@@ -142,6 +142,8 @@ protected:
   struct EFBCacheTile
   {
     bool present;
+    // Set when the tile was invalidated, but the readback texture still holds the last copy of it.
+    bool stale;
     u8 frame_access_mask;
   };
 
@@ -180,6 +182,8 @@ protected:
 
   bool IsUsingTiledEFBCache() const;
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
+  bool UseStaleEFBCacheTile(bool depth, u32 tile_index);
+  void DiscardStaleEFBCacheTiles();
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
   void PopulateEFBCache(bool depth, u32 tile_index, bool async = false);
 
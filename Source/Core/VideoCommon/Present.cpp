@@ -4,6 +4,7 @@
 #include "VideoCommon/Present.h"
 
 #include "Common/ChunkFile.h"
+#include "Common/Timer.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/Host.h"
@@ -748,7 +749,12 @@ void Presenter::Present()
   UpdateDrawRectangle();
 
   g_gfx->BeginUtilityDrawing();
+
+  // Binding the backbuffer may wait for a swap chain image, and presenting may wait for vsync,
+  // so both count towards the time the video thread spends blocked on presentation.
+  const u64 bind_start_us = Common::Timer::NowUs();
   g_gfx->BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
+  u64 present_wait_us = Common::Timer::NowUs() - bind_start_us;
 
   // Render the XFB to the screen.
   if (m_xfb_entry)
@@ -770,8 +776,11 @@ void Presenter::Present()
   // Present to the window system.
   {
     std::lock_guard<std::mutex> guard(m_swap_mutex);
+    const u64 present_start_us = Common::Timer::NowUs();
     g_gfx->PresentBackbuffer();
+    present_wait_us += Common::Timer::NowUs() - present_start_us;
   }
+  SETSTAT(g_stats.present_wait_us, present_wait_us);
 
   if (m_xfb_entry)
   {
@@ -65,6 +65,8 @@ void ShaderCache::InitializeShaderCache()
   // Queue ubershader precompiling if required.
   if (g_ActiveConfig.UsingUberShaders())
     QueueUberShaderPipelines();
+  if (g_ActiveConfig.UsingPartiallySpecializedUberShaders())
+    QueuePartiallySpecializedUberShaderPipelines();
 
   // Compile all known UIDs.
   CompileMissingPipelines();
@@ -112,15 +114,79 @@ void ShaderCache::Shutdown()
     m_async_shader_compiler->StopWorkerThreads();
 
   ClosePipelineUIDCache();
+
+  INFO_LOG_FMT(VIDEO, "Pipeline cache lookups: {} hits, {} deduplicated hits, {} misses",
+               m_pipeline_stats.hits, m_pipeline_stats.deduplicated, m_pipeline_stats.misses);
 }
 
-const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
+/// Clears render state which has no effect on the resulting pipeline, so that UIDs which only
+/// differ in these fields share a single cache entry.
+static void CanonicalizeRenderState(DepthState& depth, BlendingState& blend)
 {
+  // Backends never write depth when the depth test is disabled, and the function is unused.
+  if (!depth.testenable)
+  {
+    depth.updateenable = false;
+    depth.func = CompareMode::Never;
+  }
+
+  if (!blend.colorupdate && !blend.alphaupdate)
+  {
+    // Nothing is written to the color buffer, so blending and logic ops are irrelevant.
+    blend.hex = 0;
+  }
+  else if (!blend.blendenable && !blend.logicopenable)
+  {
+    const bool colorupdate = blend.colorupdate;
+    const bool alphaupdate = blend.alphaupdate;
+    blend.hex = 0;
+    blend.colorupdate = colorupdate;
+    blend.alphaupdate = alphaupdate;
+  }
+}
+
+static GXPipelineUid CanonicalizePipelineUid(const GXPipelineUid& in)
+{
+  GXPipelineUid out;
+  memcpy(static_cast<void*>(&out), static_cast<const void*>(&in), sizeof(out));  // copy padding
+  CanonicalizeRenderState(out.depth_state, out.blending_state);
+
+  // Forcing early depth is only needed when depth is written.
+  pixel_shader_uid_data* ps = out.ps_uid.GetUidData();
+  if (ps->ztest == EmulatedZ::ForcedEarly && !out.depth_state.updateenable)
+    ps->ztest = EmulatedZ::Early;
+
+  return out;
+}
+
+static GXUberPipelineUid CanonicalizePipelineUid(const GXUberPipelineUid& in)
+{
+  GXUberPipelineUid out;
+  memcpy(static_cast<void*>(&out), static_cast<const void*>(&in), sizeof(out));  // copy padding
+  CanonicalizeRenderState(out.depth_state, out.blending_state);
+  return out;
+}
+
+template <typename UidType>
+void ShaderCache::RecordPipelineLookup(const UidType& uid, const UidType& canonical_uid, bool hit)
+{
+  if (!hit)
+    m_pipeline_stats.misses++;
+  else if (uid != canonical_uid)
+    m_pipeline_stats.deduplicated++;
+  else
+    m_pipeline_stats.hits++;
+}
+
+const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& in_uid)
+{
+  const GXPipelineUid uid = CanonicalizePipelineUid(in_uid);
   auto it = m_gx_pipeline_cache.find(uid);
-  if (it != m_gx_pipeline_cache.end() && !it->second.second)
+  const bool exists_in_cache = it != m_gx_pipeline_cache.end();
+  RecordPipelineLookup(in_uid, uid, exists_in_cache);
+  if (exists_in_cache && !it->second.second)
     return it->second.first.get();
 
-  const bool exists_in_cache = it != m_gx_pipeline_cache.end();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
@@ -130,9 +196,12 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
   return InsertGXPipeline(uid, std::move(pipeline));
 }
 
-std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& uid)
+std::optional<const AbstractPipeline*>
+ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& in_uid)
 {
+  const GXPipelineUid uid = CanonicalizePipelineUid(in_uid);
   auto it = m_gx_pipeline_cache.find(uid);
+  RecordPipelineLookup(in_uid, uid, it != m_gx_pipeline_cache.end());
   if (it != m_gx_pipeline_cache.end())
   {
     // .second is the pending flag, i.e. compiling in the background.
@@ -147,9 +216,30 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
   return {};
 }
 
-const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineUid& uid)
+std::optional<const AbstractPipeline*>
+ShaderCache::GetUberPipelineForUidAsync(const GXUberPipelineUid& in_uid)
+{
+  const GXUberPipelineUid uid = CanonicalizePipelineUid(in_uid);
+  auto it = m_gx_uber_pipeline_cache.find(uid);
+  RecordPipelineLookup(in_uid, uid, it != m_gx_uber_pipeline_cache.end());
+  if (it != m_gx_uber_pipeline_cache.end())
+  {
+    // .second is the pending flag, i.e. compiling in the background.
+    if (!it->second.second)
+      return it->second.first.get();
+    else
+      return {};
+  }
+
+  QueueUberPipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PARTIAL_UBERSHADER_PIPELINE);
+  return {};
+}
+
+const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineUid& in_uid)
 {
+  const GXUberPipelineUid uid = CanonicalizePipelineUid(in_uid);
   auto it = m_gx_uber_pipeline_cache.find(uid);
+  RecordPipelineLookup(in_uid, uid, it != m_gx_uber_pipeline_cache.end());
   if (it != m_gx_uber_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
@@ -288,6 +378,7 @@ void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyTyp
     {
       KeyType real_uid;
       UnserializePipelineUid(key, real_uid);
+      real_uid = CanonicalizePipelineUid(real_uid);
 
       // Skip those which are already compiled.
       if (failed || cache.find(real_uid) != cache.end())
@@ -425,8 +516,12 @@ void ShaderCache::CompileMissingPipelines()
   }
   for (auto& it : m_gx_uber_pipeline_cache)
   {
-    if (!it.second.first)
-      QueueUberPipelineCompile(it.first, COMPILE_PRIORITY_UBERSHADER_PIPELINE);
+    if (it.second.first)
+      continue;
+
+    QueueUberPipelineCompile(it.first, it.first.ps_uid.GetUidData()->partially_specialized ?
+                                           COMPILE_PRIORITY_PARTIAL_UBERSHADER_PIPELINE :
+                                           COMPILE_PRIORITY_UBERSHADER_PIPELINE);
   }
 }
 
@@ -1003,6 +1098,7 @@ void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
 {
   GXPipelineUid real_uid;
   UnserializePipelineUid(uid, real_uid);
+  real_uid = CanonicalizePipelineUid(real_uid);
 
   auto iter = m_gx_pipeline_cache.find(real_uid);
   if (iter != m_gx_pipeline_cache.end())
@@ -1290,6 +1386,39 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
   m_gx_uber_pipeline_cache[uid].second = true;
 }
 
+UberShader::PixelShaderUid
+ShaderCache::GetPartiallySpecializedPixelShaderUid(const GXPipelineUid& uid)
+{
+  const GXPipelineUid canonical_uid = CanonicalizePipelineUid(uid);
+  return UberShader::GetPartiallySpecializedPixelShaderUid(
+      canonical_uid.ps_uid, canonical_uid.vs_uid.GetUidData()->numTexGens);
+}
+
+void ShaderCache::QueuePartiallySpecializedUberShaderPipelines()
+{
+  // Many specialized pipelines share the same partially specialized ubershader, so the set of
+  // pipelines known from the UID cache is a good predictor of which ones will be needed.
+  for (const auto& it : m_gx_pipeline_cache)
+  {
+    const GXPipelineUid& uid = it.first;
+    const u32 num_texgens = uid.vs_uid.GetUidData()->numTexGens;
+
+    GXUberPipelineUid config;
+    config.vertex_format =
+        VertexLoaderManager::GetUberVertexFormat(uid.vertex_format->GetVertexDeclaration());
+    config.vs_uid.GetUidData()->num_texgens = num_texgens;
+    config.gs_uid = uid.gs_uid;
+    config.ps_uid = GetPartiallySpecializedPixelShaderUid(uid);
+    config.rasterization_state = uid.rasterization_state;
+    config.depth_state = uid.depth_state;
+    config.blending_state = uid.blending_state;
+
+    // Populate with empty entries, these will be compiled afterwards.
+    if (m_gx_uber_pipeline_cache.find(config) == m_gx_uber_pipeline_cache.end())
+      m_gx_uber_pipeline_cache[config].second = false;
+  }
+}
+
 void ShaderCache::QueueUberShaderPipelines()
 {
   // Create a dummy vertex format with no attributes.
@@ -69,6 +69,12 @@ public:
   // Accesses ShaderGen shader caches asynchronously.
   // The optional will be empty if this pipeline is now background compiling.
   std::optional<const AbstractPipeline*> GetPipelineForUidAsync(const GXPipelineUid& uid);
+  std::optional<const AbstractPipeline*> GetUberPipelineForUidAsync(const GXUberPipelineUid& uid);
+
+  // Returns the pixel shader UID of the partially specialized ubershader that can stand in for
+  // the pipeline. The pipeline UID is canonicalized first, so that draws and precompilation agree.
+  static UberShader::PixelShaderUid
+  GetPartiallySpecializedPixelShaderUid(const GXPipelineUid& uid);
 
   // Shared shaders
   const AbstractShader* GetScreenQuadVertexShader() const
@@ -124,8 +130,12 @@ private:
   void ClosePipelineUIDCache();
   void CompileMissingPipelines();
   void QueueUberShaderPipelines();
+  void QueuePartiallySpecializedUberShaderPipelines();
   bool CompileSharedPipelines();
 
+  template <typename UidType>
+  void RecordPipelineLookup(const UidType& uid, const UidType& canonical_uid, bool hit);
+
   // GX shader compiler methods
   std::unique_ptr<AbstractShader> CompileVertexShader(const VertexShaderUid& uid) const;
   std::unique_ptr<AbstractShader>
@@ -184,11 +194,15 @@ private:
   // Priorities for compiling. The lower the value, the sooner the pipeline is compiled.
   // The shader cache is compiled last, as it is the least likely to be required. On demand
   // shaders are always compiled before pending ubershaders, as we want to use the ubershader
-  // for as few frames as possible, otherwise we risk framerate drops.
+  // for as few frames as possible, otherwise we risk framerate drops. Partially specialized
+  // ubershaders requested at runtime sit between the two, while those generated from the UID
+  // cache wait for the generic ubershaders, which every draw can fall back to.
   enum : u32
   {
     COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
+    COMPILE_PRIORITY_ONDEMAND_PARTIAL_UBERSHADER_PIPELINE = 150,
     COMPILE_PRIORITY_UBERSHADER_PIPELINE = 200,
+    COMPILE_PRIORITY_PARTIAL_UBERSHADER_PIPELINE = 250,
     COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
   };
 
@@ -232,6 +246,15 @@ private:
   Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
+  // Pipeline lookup statistics. Deduplicated hits are lookups which only found an existing
+  // pipeline after irrelevant state was stripped from the UID.
+  struct
+  {
+    u64 hits = 0;
+    u64 deduplicated = 0;
+    u64 misses = 0;
+  } m_pipeline_stats;
+
   // EFB copy to VRAM/RAM pipelines
   std::map<TextureConversionShaderGen::TCShaderUid, std::unique_ptr<AbstractPipeline>>
       m_efb_copy_to_vram_pipelines;
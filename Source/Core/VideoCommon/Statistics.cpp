@@ -110,8 +110,13 @@ void Statistics::Display() const
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
+  draw_statistic("Present queue depth", "%d", present_queue_depth);
+  draw_statistic("Present wait", "%d us", present_wait_us);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("EFB peek stalls:", "%d", this_frame.num_efb_peek_stalls);
+  draw_statistic("EFB stale peeks:", "%d", this_frame.num_efb_peeks_stale);
+  draw_statistic("EFB tiles prefetched:", "%d", this_frame.num_efb_tiles_prefetched);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
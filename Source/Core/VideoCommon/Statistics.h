@@ -21,6 +21,11 @@ struct Statistics
 
   int num_vertex_loaders = 0;
 
+  // Presentation latency of the last frame. The queue depth is the number of earlier frames which
+  // were still waiting to be presented when the backbuffer was bound.
+  int present_queue_depth = 0;
+  int present_wait_us = 0;
+
   std::array<float, 6> proj{};
   std::array<float, 16> gproj{};
   std::array<float, 16> g2proj{};
@@ -71,6 +76,9 @@ struct Statistics
 
     int num_efb_peeks = 0;
     int num_efb_pokes = 0;
+    int num_efb_peek_stalls = 0;
+    int num_efb_peeks_stale = 0;
+    int num_efb_tiles_prefetched = 0;
 
     int num_draw_done = 0;
     int num_token = 0;
@@ -293,6 +293,25 @@ PixelShaderUid GetPixelShaderUid()
   return out;
 }
 
+PixelShaderUid GetPartiallySpecializedPixelShaderUid(const ::PixelShaderUid& specialized_uid,
+                                                     u32 num_texgens)
+{
+  PixelShaderUid out;
+
+  const pixel_shader_uid_data* const specialized = specialized_uid.GetUidData();
+  pixel_ubershader_uid_data* const uid_data = out.GetUidData();
+  uid_data->num_texgens = num_texgens;
+  uid_data->early_depth = specialized->ztest == EmulatedZ::ForcedEarly;
+  uid_data->per_pixel_depth = specialized->per_pixel_depth;
+  uid_data->uint_output = specialized->uint_output;
+  uid_data->partially_specialized = 1;
+  uid_data->num_tev_stages = specialized->genMode_numtevstages;
+  uid_data->fog_enabled = specialized->fog_fsel != FogType::Off;
+  uid_data->alpha_test_enabled = specialized->Pretest != AlphaTestResult::Pass;
+
+  return out;
+}
+
 void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& host_config,
                                    PixelShaderUid* uid)
 {
@@ -326,6 +345,7 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
   const bool per_pixel_depth = uid_data->per_pixel_depth != 0;
   const bool bounding_box = host_config.bounding_box;
   const u32 numTexgen = uid_data->num_texgens;
+  const bool partially_specialized = uid_data->partially_specialized != 0;
   ShaderCode out;
 
   ASSERT_MSG(VIDEO, !(use_dual_source && use_framebuffer_fetch),
@@ -876,8 +896,16 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
   out.Write("void main()\n{{\n");
   out.Write("  float4 rawpos = gl_FragCoord;\n");
 
-  out.Write("  uint num_stages = {};\n\n",
-            BitfieldExtract<&GenMode::numtevstages>("bpmem_genmode"));
+  if (partially_specialized)
+  {
+    // A constant trip count lets the driver unroll the main tev loop.
+    out.Write("  const uint num_stages = {}u;\n\n", uid_data->num_tev_stages);
+  }
+  else
+  {
+    out.Write("  uint num_stages = {};\n\n",
+              BitfieldExtract<&GenMode::numtevstages>("bpmem_genmode"));
+  }
 
   bool has_custom_shader_details = false;
   if (std::any_of(custom_details.shaders.begin(), custom_details.shaders.end(),
@@ -1402,27 +1430,32 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
     out.Write("  #define discard_fragment discard\n");
   }
 
-  out.Write("  if (bpmem_alphaTest != 0u) {{\n"
-            "    bool comp0 = alphaCompare(TevResult.a, " I_ALPHA ".r, {});\n",
-            BitfieldExtract<&AlphaTest::comp0>("bpmem_alphaTest"));
-  out.Write("    bool comp1 = alphaCompare(TevResult.a, " I_ALPHA ".g, {});\n",
-            BitfieldExtract<&AlphaTest::comp1>("bpmem_alphaTest"));
-  out.Write("\n"
-            "    // These if statements are written weirdly to work around intel and Qualcomm "
-            "bugs with handling booleans.\n"
-            "    switch ({}) {{\n",
-            BitfieldExtract<&AlphaTest::logic>("bpmem_alphaTest"));
-  out.Write("    case 0u: // AND\n"
-            "      if (comp0 && comp1) break; else discard_fragment; break;\n"
-            "    case 1u: // OR\n"
-            "      if (comp0 || comp1) break; else discard_fragment; break;\n"
-            "    case 2u: // XOR\n"
-            "      if (comp0 != comp1) break; else discard_fragment; break;\n"
-            "    case 3u: // XNOR\n"
-            "      if (comp0 == comp1) break; else discard_fragment; break;\n"
-            "    }}\n"
-            "  }}\n"
-            "\n");
+  // The alphaTest uniform is zero whenever the test always passes, so there is nothing to emit
+  // when the shader is specialized for that case.
+  if (!partially_specialized || uid_data->alpha_test_enabled)
+  {
+    out.Write("  if (bpmem_alphaTest != 0u) {{\n"
+              "    bool comp0 = alphaCompare(TevResult.a, " I_ALPHA ".r, {});\n",
+              BitfieldExtract<&AlphaTest::comp0>("bpmem_alphaTest"));
+    out.Write("    bool comp1 = alphaCompare(TevResult.a, " I_ALPHA ".g, {});\n",
+              BitfieldExtract<&AlphaTest::comp1>("bpmem_alphaTest"));
+    out.Write("\n"
+              "    // These if statements are written weirdly to work around intel and Qualcomm "
+              "bugs with handling booleans.\n"
+              "    switch ({}) {{\n",
+              BitfieldExtract<&AlphaTest::logic>("bpmem_alphaTest"));
+    out.Write("    case 0u: // AND\n"
+              "      if (comp0 && comp1) break; else discard_fragment; break;\n"
+              "    case 1u: // OR\n"
+              "      if (comp0 || comp1) break; else discard_fragment; break;\n"
+              "    case 2u: // XOR\n"
+              "      if (comp0 != comp1) break; else discard_fragment; break;\n"
+              "    case 3u: // XNOR\n"
+              "      if (comp0 == comp1) break; else discard_fragment; break;\n"
+              "    }}\n"
+              "  }}\n"
+              "\n");
+  }
 
   out.Write("  // Hardware testing indicates that an alpha of 1 can pass an alpha test,\n"
             "  // but doesn't do anything in blending\n"
@@ -1442,69 +1475,73 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
   //    Fog
   // =========
 
-  // FIXME: Fog is implemented the same as ShaderGen, but ShaderGen's fog is all hacks.
-  //        Should be fixed point, and should not make guesses about Range-Based adjustments.
-  out.Write("  // Fog\n"
-            "  uint fog_function = {};\n",
-            BitfieldExtract<&FogParam3::fsel>("bpmem_fogParam3"));
-  out.Write("  if (fog_function != {:s}) {{\n", FogType::Off);
-  out.Write("    // TODO: This all needs to be converted from float to fixed point\n"
-            "    float ze;\n"
-            "    if ({} == 0u) {{\n",
-            BitfieldExtract<&FogParam3::proj>("bpmem_fogParam3"));
-  out.Write("      // perspective\n"
-            "      // ze = A/(B - (Zs >> B_SHF)\n"
-            "      ze = (" I_FOGF ".x * 16777216.0) / float(" I_FOGI ".y - (zCoord >> " I_FOGI
-            ".w));\n"
-            "    }} else {{\n"
-            "      // orthographic\n"
-            "      // ze = a*Zs    (here, no B_SHF)\n"
-            "      ze = " I_FOGF ".x * float(zCoord) / 16777216.0;\n"
-            "    }}\n"
-            "\n"
-            "    if (bool({})) {{\n",
-            BitfieldExtract<&FogRangeParams::RangeBase::Enabled>("bpmem_fogRangeBase"));
-  out.Write("      // x_adjust = sqrt((x-center)^2 + k^2)/k\n"
-            "      // ze *= x_adjust\n"
-            "      float offset = (2.0 * (rawpos.x / " I_FOGF ".w)) - 1.0 - " I_FOGF ".z;\n"
-            "      float floatindex = clamp(9.0 - abs(offset) * 9.0, 0.0, 9.0);\n"
-            "      uint indexlower = uint(floatindex);\n"
-            "      uint indexupper = indexlower + 1u;\n"
-            "      float klower = " I_FOGRANGE "[indexlower >> 2u][indexlower & 3u];\n"
-            "      float kupper = " I_FOGRANGE "[indexupper >> 2u][indexupper & 3u];\n"
-            "      float k = lerp(klower, kupper, frac(floatindex));\n"
-            "      float x_adjust = sqrt(offset * offset + k * k) / k;\n"
-            "      ze *= x_adjust;\n"
-            "    }}\n"
-            "\n"
-            "    float fog = clamp(ze - " I_FOGF ".y, 0.0, 1.0);\n"
-            "\n");
-  out.Write("    if (fog_function >= {:s}) {{\n", FogType::Exp);
-  out.Write("      switch (fog_function) {{\n"
-            "      case {:s}:\n"
-            "        fog = 1.0 - exp2(-8.0 * fog);\n"
-            "        break;\n",
-            FogType::Exp);
-  out.Write("      case {:s}:\n"
-            "        fog = 1.0 - exp2(-8.0 * fog * fog);\n"
-            "        break;\n",
-            FogType::ExpSq);
-  out.Write("      case {:s}:\n"
-            "        fog = exp2(-8.0 * (1.0 - fog));\n"
-            "        break;\n",
-            FogType::BackwardsExp);
-  out.Write("      case {:s}:\n"
-            "        fog = 1.0 - fog;\n"
-            "        fog = exp2(-8.0 * fog * fog);\n"
-            "        break;\n",
-            FogType::BackwardsExpSq);
-  out.Write("      }}\n"
-            "    }}\n"
-            "\n"
-            "    int ifog = iround(fog * 256.0);\n"
-            "    TevResult.rgb = (TevResult.rgb * (256 - ifog) + " I_FOGCOLOR ".rgb * ifog) >> 8;\n"
-            "  }}\n"
-            "\n");
+  if (!partially_specialized || uid_data->fog_enabled)
+  {
+    // FIXME: Fog is implemented the same as ShaderGen, but ShaderGen's fog is all hacks.
+    //        Should be fixed point, and should not make guesses about Range-Based adjustments.
+    out.Write("  // Fog\n"
+              "  uint fog_function = {};\n",
+              BitfieldExtract<&FogParam3::fsel>("bpmem_fogParam3"));
+    out.Write("  if (fog_function != {:s}) {{\n", FogType::Off);
+    out.Write("    // TODO: This all needs to be converted from float to fixed point\n"
+              "    float ze;\n"
+              "    if ({} == 0u) {{\n",
+              BitfieldExtract<&FogParam3::proj>("bpmem_fogParam3"));
+    out.Write("      // perspective\n"
+              "      // ze = A/(B - (Zs >> B_SHF)\n"
+              "      ze = (" I_FOGF ".x * 16777216.0) / float(" I_FOGI ".y - (zCoord >> " I_FOGI
+              ".w));\n"
+              "    }} else {{\n"
+              "      // orthographic\n"
+              "      // ze = a*Zs    (here, no B_SHF)\n"
+              "      ze = " I_FOGF ".x * float(zCoord) / 16777216.0;\n"
+              "    }}\n"
+              "\n"
+              "    if (bool({})) {{\n",
+              BitfieldExtract<&FogRangeParams::RangeBase::Enabled>("bpmem_fogRangeBase"));
+    out.Write("      // x_adjust = sqrt((x-center)^2 + k^2)/k\n"
+              "      // ze *= x_adjust\n"
+              "      float offset = (2.0 * (rawpos.x / " I_FOGF ".w)) - 1.0 - " I_FOGF ".z;\n"
+              "      float floatindex = clamp(9.0 - abs(offset) * 9.0, 0.0, 9.0);\n"
+              "      uint indexlower = uint(floatindex);\n"
+              "      uint indexupper = indexlower + 1u;\n"
+              "      float klower = " I_FOGRANGE "[indexlower >> 2u][indexlower & 3u];\n"
+              "      float kupper = " I_FOGRANGE "[indexupper >> 2u][indexupper & 3u];\n"
+              "      float k = lerp(klower, kupper, frac(floatindex));\n"
+              "      float x_adjust = sqrt(offset * offset + k * k) / k;\n"
+              "      ze *= x_adjust;\n"
+              "    }}\n"
+              "\n"
+              "    float fog = clamp(ze - " I_FOGF ".y, 0.0, 1.0);\n"
+              "\n");
+    out.Write("    if (fog_function >= {:s}) {{\n", FogType::Exp);
+    out.Write("      switch (fog_function) {{\n"
+              "      case {:s}:\n"
+              "        fog = 1.0 - exp2(-8.0 * fog);\n"
+              "        break;\n",
+              FogType::Exp);
+    out.Write("      case {:s}:\n"
+              "        fog = 1.0 - exp2(-8.0 * fog * fog);\n"
+              "        break;\n",
+              FogType::ExpSq);
+    out.Write("      case {:s}:\n"
+              "        fog = exp2(-8.0 * (1.0 - fog));\n"
+              "        break;\n",
+              FogType::BackwardsExp);
+    out.Write("      case {:s}:\n"
+              "        fog = 1.0 - fog;\n"
+              "        fog = exp2(-8.0 * fog * fog);\n"
+              "        break;\n",
+              FogType::BackwardsExpSq);
+    out.Write("      }}\n"
+              "    }}\n"
+              "\n"
+              "    int ifog = iround(fog * 256.0);\n"
+              "    TevResult.rgb = (TevResult.rgb * (256 - ifog) + " I_FOGCOLOR
+              ".rgb * ifog) >> 8;\n"
+              "  }}\n"
+              "\n");
+  }
 
   if (use_framebuffer_fetch)
   {
@@ -5,6 +5,7 @@
 
 #include <functional>
 #include "Common/CommonTypes.h"
+#include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/ShaderGenCommon.h"
 
 enum class APIType;
@@ -20,6 +21,13 @@ struct pixel_ubershader_uid_data
   u32 uint_output : 1;
   u32 no_dual_src : 1;
 
+  // Partially specialized ubershaders bake a small subset of the GX state into the shader, so
+  // that the stage loop has a constant trip count and unused fog/alpha test code is removed.
+  u32 partially_specialized : 1;
+  u32 num_tev_stages : 4;  // genMode.numtevstages, i.e. the stage count minus one
+  u32 fog_enabled : 1;
+  u32 alpha_test_enabled : 1;
+
   u32 NumValues() const { return sizeof(pixel_ubershader_uid_data); }
 };
 #pragma pack()
@@ -28,6 +36,11 @@ using PixelShaderUid = ShaderUid<pixel_ubershader_uid_data>;
 
 PixelShaderUid GetPixelShaderUid();
 
+// Returns the partially specialized ubershader UID covering the given specialized pixel shader.
+// num_texgens must match the vertex shader, as with the generic ubershader.
+PixelShaderUid GetPartiallySpecializedPixelShaderUid(const ::PixelShaderUid& specialized_uid,
+                                                     u32 num_texgens);
+
 ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
                           const pixel_ubershader_uid_data* uid_data,
                           const CustomPixelShaderContents& custom_details);
@@ -44,9 +57,15 @@ struct fmt::formatter<UberShader::pixel_ubershader_uid_data>
   template <typename FormatContext>
   auto format(const UberShader::pixel_ubershader_uid_data& uid, FormatContext& ctx) const
   {
-    return fmt::format_to(
+    auto out = fmt::format_to(
         ctx.out(), "Pixel UberShader for {} texgens{}{}{}{}", uid.num_texgens,
         uid.early_depth ? ", early-depth" : "", uid.per_pixel_depth ? ", per-pixel depth" : "",
         uid.uint_output ? ", uint output" : "", uid.no_dual_src ? ", no dual-source blending" : "");
+    if (!uid.partially_specialized)
+      return out;
+
+    return fmt::format_to(out, ", specialized for {} stages{}{}", uid.num_tev_stages + 1,
+                          uid.fog_enabled ? ", fog" : "",
+                          uid.alpha_test_enabled ? ", alpha test" : "");
   }
 };
@@ -895,6 +895,22 @@ void VertexManagerBase::UpdatePipelineObject()
       return;
     }
 
+    if (g_ActiveConfig.UsingPartiallySpecializedUberShaders())
+    {
+      // Prefer an ubershader specialized on part of the state if one has been compiled. The
+      // pipeline object is invalidated every frame, so we switch over once it is ready.
+      VideoCommon::GXUberPipelineUid partial_config = m_current_uber_pipeline_config;
+      partial_config.ps_uid = VideoCommon::ShaderCache::GetPartiallySpecializedPixelShaderUid(
+          m_current_pipeline_config);
+
+      auto partial_res = g_shader_cache->GetUberPipelineForUidAsync(partial_config);
+      if (partial_res && *partial_res)
+      {
+        m_current_pipeline_object = *partial_res;
+        return;
+      }
+    }
+
     if (g_ActiveConfig.iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders)
     {
       // Specialized shaders not ready, use the ubershaders.
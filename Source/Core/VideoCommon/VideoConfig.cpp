@@ -126,6 +126,7 @@ void VideoConfig::Refresh()
   sDumpCodec = Config::Get(Config::GFX_DUMP_CODEC);
   sDumpPixelFormat = Config::Get(Config::GFX_DUMP_PIXEL_FORMAT);
   sDumpEncoder = Config::Get(Config::GFX_DUMP_ENCODER);
+  bDumpHardwareEncoder = Config::Get(Config::GFX_DUMP_HARDWARE_ENCODER);
   sDumpPath = Config::Get(Config::GFX_DUMP_PATH);
   iBitrateKbps = Config::Get(Config::GFX_BITRATE_KBPS);
   bInternalResolutionFrameDumps = Config::Get(Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS);
@@ -144,9 +145,13 @@ void VideoConfig::Refresh()
   bEnableValidationLayer = Config::Get(Config::GFX_ENABLE_VALIDATION_LAYER);
   bBackendMultithreading = Config::Get(Config::GFX_BACKEND_MULTITHREADING);
   iCommandBufferExecuteInterval = Config::Get(Config::GFX_COMMAND_BUFFER_EXECUTE_INTERVAL);
+  iPresentQueueDepth = std::clamp(Config::Get(Config::GFX_PRESENT_QUEUE_DEPTH), 1,
+                                  MAX_PRESENT_QUEUE_DEPTH);
+  bPreferMailboxPresent = Config::Get(Config::GFX_PREFER_MAILBOX_PRESENT);
   bShaderCache = Config::Get(Config::GFX_SHADER_CACHE);
   bWaitForShadersBeforeStarting = Config::Get(Config::GFX_WAIT_FOR_SHADERS_BEFORE_STARTING);
   iShaderCompilationMode = Config::Get(Config::GFX_SHADER_COMPILATION_MODE);
+  bPartiallySpecializedUberShaders = Config::Get(Config::GFX_PARTIALLY_SPECIALIZED_UBERSHADERS);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
   bCPUCull = Config::Get(Config::GFX_CPU_CULL);
@@ -180,6 +185,7 @@ void VideoConfig::Refresh()
 
   bEFBAccessEnable = Config::Get(Config::GFX_HACK_EFB_ACCESS_ENABLE);
   bEFBAccessDeferInvalidation = Config::Get(Config::GFX_HACK_EFB_DEFER_INVALIDATION);
+  bEFBAccessAsyncPeeks = Config::Get(Config::GFX_HACK_EFB_ASYNC_PEEKS);
   bBBoxEnable = Config::Get(Config::GFX_HACK_BBOX_ENABLE);
   bForceProgressive = Config::Get(Config::GFX_HACK_FORCE_PROGRESSIVE);
   bSkipEFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
@@ -234,6 +240,12 @@ bool VideoConfig::UsingUberShaders() const
          iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders;
 }
 
+bool VideoConfig::UsingPartiallySpecializedUberShaders() const
+{
+  return bPartiallySpecializedUberShaders &&
+         iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders;
+}
+
 static u32 GetNumAutoShaderCompilerThreads()
 {
   // Automatic number.
@@ -295,6 +307,8 @@ void CheckForConfigChanges()
   const bool old_widescreen_hack = g_ActiveConfig.bWidescreenHack;
   const auto old_post_processing_shader = g_ActiveConfig.sPostProcessingShader;
   const auto old_hdr = g_ActiveConfig.bHDR;
+  const int old_present_queue_depth = g_ActiveConfig.iPresentQueueDepth;
+  const bool old_prefer_mailbox_present = g_ActiveConfig.bPreferMailboxPresent;
 
   UpdateActiveConfig();
   FreeLook::UpdateActiveConfig();
@@ -350,6 +364,11 @@ void CheckForConfigChanges()
     changed_bits |= CONFIG_CHANGE_BIT_POST_PROCESSING_SHADER;
   if (old_hdr != g_ActiveConfig.bHDR)
     changed_bits |= CONFIG_CHANGE_BIT_HDR;
+  if (old_present_queue_depth != g_ActiveConfig.iPresentQueueDepth ||
+      old_prefer_mailbox_present != g_ActiveConfig.bPreferMailboxPresent)
+  {
+    changed_bits |= CONFIG_CHANGE_BIT_PRESENT_MODE;
+  }
 
   // No changes?
   if (changed_bits == 0)
@@ -18,6 +18,7 @@
 #include "VideoCommon/VideoCommon.h"
 
 constexpr int EFB_SCALE_AUTO_INTEGRAL = 0;
+constexpr int MAX_PRESENT_QUEUE_DEPTH = 2;
 
 enum class AspectMode : int
 {
@@ -92,6 +93,7 @@ enum ConfigChangeBits : u32
   CONFIG_CHANGE_BIT_ASPECT_RATIO = (1 << 8),
   CONFIG_CHANGE_BIT_POST_PROCESSING_SHADER = (1 << 9),
   CONFIG_CHANGE_BIT_HDR = (1 << 10),
+  CONFIG_CHANGE_BIT_PRESENT_MODE = (1 << 11),
 };
 
 // NEVER inherit from this class.
@@ -185,6 +187,7 @@ struct VideoConfig final
   std::string sDumpCodec;
   std::string sDumpPixelFormat;
   std::string sDumpEncoder;
+  bool bDumpHardwareEncoder = false;
   std::string sDumpFormat;
   std::string sDumpPath;
   bool bInternalResolutionFrameDumps = false;
@@ -198,6 +201,7 @@ struct VideoConfig final
   // Hacks
   bool bEFBAccessEnable = false;
   bool bEFBAccessDeferInvalidation = false;
+  bool bEFBAccessAsyncPeeks = false;
   bool bPerfQueriesEnable = false;
   bool bBBoxEnable = false;
   bool bForceProgressive = false;
@@ -252,9 +256,18 @@ struct VideoConfig final
   // Currently only supported with Vulkan.
   int iCommandBufferExecuteInterval = 0;
 
+  // Number of frames which can be queued for presentation on the submission thread before the
+  // video thread waits, and whether to prefer mailbox presentation when vsync is enabled.
+  // Currently only supported with Vulkan, and only when multithreaded submission is enabled.
+  int iPresentQueueDepth = 1;
+  bool bPreferMailboxPresent = false;
+
   // Shader compilation settings.
   bool bWaitForShadersBeforeStarting = false;
   ShaderCompilationMode iShaderCompilationMode{};
+  // Use ubershaders specialized on a small subset of state while waiting for the fully
+  // specialized shader. Only used with hybrid ubershaders.
+  bool bPartiallySpecializedUberShaders = false;
 
   // Number of shader compiler threads.
   // 0 disables background compilation.
@@ -366,6 +379,7 @@ struct VideoConfig final
     return false;
   }
   bool UsingUberShaders() const;
+  bool UsingPartiallySpecializedUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
 
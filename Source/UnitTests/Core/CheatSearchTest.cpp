@@ -0,0 +1,239 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/CheatSearch.h"
+#include "Core/CheatSearchInternal.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/System.h"
+
+namespace
+{
+constexpr u32 SEARCH_SIZE = 0x20000;
+constexpr u32 PAGE_SIZE = 0x1000;
+constexpr PowerPC::RequestedAddressSpace SPACE = PowerPC::RequestedAddressSpace::Physical;
+
+template <typename T>
+std::optional<PowerPC::ReadResult<T>> Read(const Core::CPUThreadGuard& guard, u32 address)
+{
+  if constexpr (sizeof(T) == 1)
+    return PowerPC::MMU::HostTryReadU8(guard, address, SPACE);
+  else
+    return PowerPC::MMU::HostTryReadU32(guard, address, SPACE);
+}
+
+template <typename T>
+Cheats::SearchResult<T> MakeResult(u32 address, const std::optional<PowerPC::ReadResult<T>>& value)
+{
+  Cheats::SearchResult<T> result{};
+  result.m_address = address;
+  result.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
+  if (value)
+  {
+    result.m_value = value->value;
+    result.m_value_state = Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+  }
+  return result;
+}
+
+// The straightforward serial versions of the searches, one MMU read per value
+template <typename T>
+std::vector<Cheats::SearchResult<T>>
+SerialNewSearch(const Core::CPUThreadGuard& guard, const std::vector<Cheats::MemoryRange>& ranges,
+                bool aligned, const std::function<bool(const T& value)>& validator)
+{
+  std::vector<Cheats::SearchResult<T>> results;
+  for (const Cheats::MemoryRange& range : ranges)
+  {
+    const u32 increment = aligned ? sizeof(T) : 1;
+    for (u64 addr = range.m_start; addr + sizeof(T) <= range.m_start + range.m_length;
+         addr += increment)
+    {
+      if (aligned && addr % sizeof(T) != 0)
+        continue;
+      const auto value = Read<T>(guard, static_cast<u32>(addr));
+      if (value && validator(value->value))
+        results.push_back(MakeResult(static_cast<u32>(addr), value));
+    }
+  }
+  return results;
+}
+
+template <typename T>
+std::vector<Cheats::SearchResult<T>> ToVector(const Cheats::SearchResults<T>& results)
+{
+  std::vector<Cheats::SearchResult<T>> vector;
+  for (size_t i = 0; i < results.Size(); ++i)
+    vector.push_back(results.Get(i));
+  return vector;
+}
+
+template <typename T>
+std::vector<Cheats::SearchResult<T>>
+SerialNextSearch(const Core::CPUThreadGuard& guard,
+                 const Cheats::SearchResults<T>& previous_results,
+                 const std::function<bool(const T& new_value, const T& old_value)>& validator)
+{
+  std::vector<Cheats::SearchResult<T>> results;
+  for (const Cheats::SearchResult<T>& previous_result : ToVector(previous_results))
+  {
+    const auto value = Read<T>(guard, previous_result.m_address);
+    if (!value || !previous_result.IsValueValid() ||
+        validator(value->value, previous_result.m_value))
+    {
+      results.push_back(MakeResult(previous_result.m_address, value));
+    }
+  }
+  return results;
+}
+
+template <typename T>
+void ExpectSameResults(const Cheats::SearchResults<T>& results,
+                       const std::vector<Cheats::SearchResult<T>>& expected)
+{
+  const auto valid_count =
+      std::count_if(expected.begin(), expected.end(),
+                    [](const Cheats::SearchResult<T>& result) { return result.IsValueValid(); });
+  ASSERT_EQ(results.GetValidValueCount(), static_cast<size_t>(valid_count));
+
+  const std::vector<Cheats::SearchResult<T>> actual = ToVector(results);
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i)
+  {
+    ASSERT_EQ(actual[i].m_address, expected[i].m_address) << "result " << i;
+    ASSERT_EQ(actual[i].m_value_state, expected[i].m_value_state) << "result " << i;
+    if (expected[i].IsValueValid())
+    {
+      ASSERT_EQ(actual[i].m_value, expected[i].m_value) << "result " << i;
+    }
+  }
+}
+}  // namespace
+
+class CheatSearchTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Core::DeclareAsCPUThread();
+    m_memory.Init();
+
+    // Lots of small values, so that searches find many results in every page
+    std::mt19937 rng(1234);
+    for (u32 i = 0; i < SEARCH_SIZE; ++i)
+      m_memory.GetRAM()[i] = static_cast<u8>(rng() % 4);
+
+    // Values that cross into the next page, and one that crosses the end of RAM
+    WriteU32(PAGE_SIZE - 2, 0);
+    WriteU32(3 * PAGE_SIZE - 1, 0);
+    WriteU32(m_memory.GetRamSizeReal() - 2, 0);
+  }
+
+  void TearDown() override
+  {
+    m_memory.Shutdown();
+    Core::UndeclareAsCPUThread();
+  }
+
+  void WriteU32(u32 address, u32 value)
+  {
+    const u32 swapped = Common::swap32(value);
+    const u32 size = std::min<u32>(sizeof(swapped), m_memory.GetRamSizeReal() - address);
+    std::memcpy(m_memory.GetRAM() + address, &swapped, size);
+  }
+
+  std::vector<Cheats::MemoryRange> GetRanges() const
+  {
+    // The second range ends past the end of RAM, where values have to be read through the MMU
+    return {Cheats::MemoryRange(0, SEARCH_SIZE),
+            Cheats::MemoryRange(m_memory.GetRamSizeReal() - 2 * PAGE_SIZE - 1, 4 * PAGE_SIZE)};
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  Memory::MemoryManager& m_memory = m_system.GetMemory();
+};
+
+TEST_F(CheatSearchTest, NewSearchU8)
+{
+  Core::CPUThreadGuard guard(m_system);
+  const std::function<bool(const u8&)> validator = [](const u8& value) { return value == 0; };
+
+  const auto results = Cheats::SearchMemory<u8>(guard, GetRanges(), SPACE, true, validator);
+  EXPECT_NE(results.Size(), 0u);
+  ExpectSameResults(results, SerialNewSearch<u8>(guard, GetRanges(), true, validator));
+}
+
+TEST_F(CheatSearchTest, NewSearchU32)
+{
+  Core::CPUThreadGuard guard(m_system);
+  const std::function<bool(const u32&)> validator = [](const u32& value) {
+    return value < 0x01000000;
+  };
+
+  for (const bool aligned : {true, false})
+  {
+    const auto results = Cheats::SearchMemory<u32>(guard, GetRanges(), SPACE, aligned, validator);
+    EXPECT_NE(results.Size(), 0u);
+    ExpectSameResults(results, SerialNewSearch<u32>(guard, GetRanges(), aligned, validator));
+  }
+}
+
+TEST_F(CheatSearchTest, NextSearchU32)
+{
+  Core::CPUThreadGuard guard(m_system);
+  const std::function<bool(const u32&)> new_validator = [](const u32& value) {
+    return value < 0x02000000;
+  };
+  auto previous_results =
+      Cheats::SearchMemory<u32>(guard, GetRanges(), SPACE, false, new_validator);
+  ASSERT_NE(previous_results.Size(), 0u);
+
+  // A result whose address can't be read
+  previous_results.m_addresses.AddBlock(m_memory.GetRamSizeReal() + 4, sizeof(u32), 1, {1});
+  previous_results.m_inaccessible.push_back(previous_results.m_values.size());
+  previous_results.m_values.push_back(0);
+
+  // Change some of the values, including the ones that cross pages
+  std::mt19937 rng(5678);
+  for (u32 i = 0; i < SEARCH_SIZE / 0x10; ++i)
+    m_memory.GetRAM()[rng() % SEARCH_SIZE] = static_cast<u8>(rng());
+  WriteU32(PAGE_SIZE - 2, 1);
+  WriteU32(3 * PAGE_SIZE - 1, 1);
+
+  const std::function<bool(const u32&, const u32&)> next_validator =
+      [](const u32& new_value, const u32& old_value) { return new_value != old_value; };
+  const auto results =
+      Cheats::SearchPreviousResults<u32>(guard, previous_results, SPACE, next_validator);
+  EXPECT_NE(results.Size(), 0u);
+  ExpectSameResults(results, SerialNextSearch<u32>(guard, previous_results, next_validator));
+}
+
+TEST_F(CheatSearchTest, SliceU8)
+{
+  Core::CPUThreadGuard guard(m_system);
+  const std::function<bool(const u8&)> validator = [](const u8& value) { return value == 0; };
+  const auto results = Cheats::SearchMemory<u8>(guard, GetRanges(), SPACE, false, validator);
+  const auto all_results = ToVector(results);
+
+  // Slices that start and end within blocks of results, and ones that cover whole blocks
+  for (const auto& [begin, end] : std::vector<std::pair<size_t, size_t>>{
+           {0, results.Size()}, {1, 2}, {100, 5000}, {results.Size() / 2, results.Size()}})
+  {
+    const std::vector<Cheats::SearchResult<u8>> expected(all_results.begin() + begin,
+                                                         all_results.begin() + end);
+    ExpectSameResults(results.Slice(begin, end), expected);
+  }
+}
@@ -0,0 +1,163 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Swap.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DiscUtils.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/WIABlob.h"
+
+namespace
+{
+constexpr u64 IMAGE_SIZE = 0x800000;
+constexpr int GCZ_BLOCK_SIZE = 0x8000;
+constexpr int RVZ_CHUNK_SIZE = 0x20000;
+constexpr size_t THREAD_COUNT = 4;
+constexpr size_t READS_PER_THREAD = 200;
+}  // namespace
+
+class ConcurrentReadTest : public testing::Test
+{
+protected:
+  ConcurrentReadTest()
+      : m_directory(File::CreateTempDir()), m_iso_path(m_directory + "/game.iso"),
+        m_data(IMAGE_SIZE)
+  {
+  }
+
+  ~ConcurrentReadTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    ASSERT_FALSE(m_directory.empty());
+
+    // A mix of runs and noise, so that the compressed images contain both compressed and stored
+    // blocks, and the blocks differ from each other
+    std::mt19937 rng(1234);
+    for (size_t i = 0; i < m_data.size();)
+    {
+      const size_t run = std::min<size_t>(rng() % 0x1000 + 1, m_data.size() - i);
+      const bool noise = rng() % 2 == 0;
+      const u8 value = static_cast<u8>(rng());
+      for (size_t j = 0; j < run; ++j)
+        m_data[i + j] = noise ? static_cast<u8>(rng()) : value;
+      i += run;
+    }
+
+    const u32 magic = Common::swap32(DiscIO::GAMECUBE_DISC_MAGIC);
+    std::memcpy(m_data.data() + 0x1C, &magic, sizeof(magic));
+
+    File::IOFile file(m_iso_path, "wb");
+    ASSERT_TRUE(file.WriteBytes(m_data.data(), m_data.size()));
+  }
+
+  std::unique_ptr<DiscIO::Volume> OpenVolume(const std::string& path)
+  {
+    std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateVolume(path);
+    EXPECT_NE(volume, nullptr);
+    return volume;
+  }
+
+  // Reads the whole image serially and in parallel, and then reads random ranges on several
+  // threads with ReadConcurrent while the main thread keeps reading with Read.
+  void CheckReads(const std::string& path)
+  {
+    std::unique_ptr<DiscIO::Volume> volume = OpenVolume(path);
+    ASSERT_NE(volume, nullptr);
+
+    std::vector<u8> serial(IMAGE_SIZE);
+    for (u64 offset = 0; offset < IMAGE_SIZE; offset += GCZ_BLOCK_SIZE)
+    {
+      ASSERT_TRUE(volume->Read(offset, GCZ_BLOCK_SIZE, serial.data() + offset,
+                               DiscIO::PARTITION_NONE));
+    }
+    ASSERT_EQ(serial, m_data);
+
+    std::vector<u8> parallel(IMAGE_SIZE);
+    ASSERT_TRUE(volume->ReadInParallel(0, IMAGE_SIZE, parallel.data(), DiscIO::PARTITION_NONE));
+    EXPECT_EQ(parallel, serial);
+
+    const auto read_randomly = [&](unsigned int seed, bool concurrent) {
+      std::mt19937 rng(seed);
+      std::vector<u8> buffer;
+      for (size_t i = 0; i < READS_PER_THREAD; ++i)
+      {
+        const u64 offset = rng() % IMAGE_SIZE;
+        const u64 size = std::min<u64>(rng() % 0x30000 + 1, IMAGE_SIZE - offset);
+        buffer.resize(size);
+
+        const bool success =
+            concurrent ?
+                volume->ReadConcurrent(offset, size, buffer.data(), DiscIO::PARTITION_NONE) :
+                volume->Read(offset, size, buffer.data(), DiscIO::PARTITION_NONE);
+        if (!success || !std::equal(buffer.begin(), buffer.end(), serial.begin() + offset))
+          return false;
+      }
+      return true;
+    };
+
+    std::vector<std::future<bool>> futures;
+    for (size_t i = 0; i < THREAD_COUNT; ++i)
+      futures.push_back(std::async(std::launch::async, read_randomly, i + 1, true));
+
+    // Sequential reads on the main thread also make the reader prefetch upcoming chunks
+    std::vector<u8> block(GCZ_BLOCK_SIZE);
+    for (u64 offset = 0; offset < IMAGE_SIZE; offset += GCZ_BLOCK_SIZE)
+    {
+      ASSERT_TRUE(volume->Read(offset, GCZ_BLOCK_SIZE, block.data(), DiscIO::PARTITION_NONE));
+      EXPECT_TRUE(std::equal(block.begin(), block.end(), serial.begin() + offset));
+    }
+    EXPECT_TRUE(read_randomly(0, false));
+
+    for (std::future<bool>& future : futures)
+      EXPECT_TRUE(future.get());
+  }
+
+  const std::string m_directory;
+  const std::string m_iso_path;
+  std::vector<u8> m_data;
+};
+
+TEST_F(ConcurrentReadTest, GCZ)
+{
+  const std::string gcz_path = m_directory + "/game.gcz";
+  {
+    std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(m_iso_path);
+    ASSERT_NE(reader, nullptr);
+    ASSERT_TRUE(DiscIO::ConvertToGCZ(reader.get(), m_iso_path, gcz_path, 0, GCZ_BLOCK_SIZE,
+                                     [](const std::string&, float) { return true; }));
+  }
+
+  CheckReads(gcz_path);
+}
+
+TEST_F(ConcurrentReadTest, RVZ)
+{
+  const std::string rvz_path = m_directory + "/game.rvz";
+  {
+    std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(m_iso_path);
+    ASSERT_NE(reader, nullptr);
+    ASSERT_TRUE(DiscIO::ConvertToWIAOrRVZ(reader.get(), m_iso_path, rvz_path, true,
+                                          DiscIO::WIARVZCompressionType::Zstd, 5, RVZ_CHUNK_SIZE,
+                                          [](const std::string&, float) { return true; }));
+  }
+
+  CheckReads(rvz_path);
+}